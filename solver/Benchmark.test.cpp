@@ -0,0 +1,121 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <QJsonObject>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include "JsonStates.test.h"
+#include "Solver.h"
+#include "State.h"
+
+namespace {
+	std::atomic<std::size_t> nbAllocations = 0;
+}
+
+// Counts every allocation of the benchmark executable, which is separate from the tests so that they keep the default allocator
+void *operator new(std::size_t size)
+{
+	++nbAllocations;
+	if (auto pointer = std::malloc(size == 0 ? 1 : size)) {
+		return pointer;
+	}
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+std::size_t countAllocations(std::function<void()> const &function)
+{
+	auto const nbAllocationsBefore = nbAllocations.load();
+	function();
+	return nbAllocations.load() - nbAllocationsBefore;
+}
+
+TEST_CASE("State lookups do not allocate") {
+	State state({});
+	state.import(getLargeJsonState());
+
+	std::size_t nbTeachers = 0;
+	std::size_t nbTimeslots = 0;
+	auto const nbLookupAllocations = countAllocations([&]() {
+		for (auto const &subject: state.getSubjects()) {
+			nbTeachers += state.getTeachersOfSubject(subject).size();
+		}
+
+		for (auto const &trio: state.getTrios()) {
+			for (auto const &week: state.getWeeks()) {
+				nbTimeslots += state.getAvailableTimeslots(trio, week).size();
+			}
+		}
+	});
+
+	REQUIRE(nbTeachers == state.getTeachers().size());
+	REQUIRE(nbTimeslots > 0);
+	REQUIRE(nbLookupAllocations == 0);
+}
+
+TEST_CASE("State", "[.][benchmark]") {
+	auto const &jsonState = getLargeJsonState();
+	State state({});
+
+	WARN("Allocations during the import: " << countAllocations([&]() { state.import(jsonState); }));
+	WARN("Allocations of the available timeslots of every potential colle: " << countAllocations([&]() {
+		for (auto const &teacher: state.getTeachers()) {
+			for (auto const &trio: state.getTrios()) {
+				for (auto const &week: state.getWeeks()) {
+					state.getAvailableTimeslots(teacher, trio, week);
+				}
+			}
+		}
+	}));
+
+	BENCHMARK("import") {
+		state.import(jsonState);
+	};
+
+	BENCHMARK("getAvailableTimeslots") {
+		std::size_t nbTimeslots = 0;
+		for (auto const &teacher: state.getTeachers()) {
+			for (auto const &trio: state.getTrios()) {
+				for (auto const &week: state.getWeeks()) {
+					nbTimeslots += state.getAvailableTimeslots(teacher, trio, week).size();
+				}
+			}
+		}
+
+		return nbTimeslots;
+	};
+}
+
+TEST_CASE("Redundant constraints", "[.][benchmark]") {
+	for (bool const redundantConstraints: {false, true}) {
+		auto jsonState = getLargeJsonState();
+		jsonState["solverParameters"] = QJsonObject({{"redundantConstraints", redundantConstraints}, {"progressInterval", 0}});
+
+		State state;
+		state.import(jsonState);
+		Solver solver(state);
+
+		// Only the first solution matters
+		auto const start = std::chrono::steady_clock::now();
+		std::chrono::duration<double> durationToFirstSolution;
+		solver.compute([&](auto const &, auto const &, auto const &) {
+			durationToFirstSolution = std::chrono::steady_clock::now() - start;
+			solver.stopComputation();
+		});
+
+		WARN("Duration to the first solution " << (redundantConstraints ? "with" : "without") << " redundant constraints: " << durationToFirstSolution.count() << " s");
+	}
+}
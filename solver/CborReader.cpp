@@ -0,0 +1,114 @@
+#include "CborReader.h"
+
+#include <QCborValue>
+
+CborReader::CborReader(QByteArray const &data): reader(data)
+{
+}
+
+bool CborReader::hasError() const
+{
+	return reader.lastError() != QCborError::NoError;
+}
+
+bool CborReader::isNull() const
+{
+	return reader.isNull() || reader.isUndefined();
+}
+
+void CborReader::readMap(std::function<void(QString const &key)> const &readValue)
+{
+	if (!reader.isMap()) {
+		skip();
+		return;
+	}
+
+	reader.enterContainer();
+	while (reader.hasNext() && !hasError()) {
+		auto const &key = readString();
+		readValue(key);
+	}
+
+	if (!hasError()) {
+		reader.leaveContainer();
+	}
+}
+
+void CborReader::readArray(std::function<void()> const &readElement)
+{
+	if (!reader.isArray()) {
+		skip();
+		return;
+	}
+
+	reader.enterContainer();
+	while (reader.hasNext() && !hasError()) {
+		readElement();
+	}
+
+	if (!hasError()) {
+		reader.leaveContainer();
+	}
+}
+
+QString CborReader::readString()
+{
+	if (!reader.isString()) {
+		skip();
+		return {};
+	}
+
+	// Long strings may be split into several chunks
+	QString string;
+	auto chunk = reader.readString();
+	while (chunk.status == QCborStreamReader::Ok) {
+		string += chunk.data;
+		chunk = reader.readString();
+	}
+
+	return string;
+}
+
+int CborReader::readInt()
+{
+	return static_cast<int>(readDouble());
+}
+
+double CborReader::readDouble()
+{
+	double value = 0;
+	if (reader.isInteger()) {
+		value = reader.toInteger();
+	}
+	else if (reader.isDouble()) {
+		value = reader.toDouble();
+	}
+	else if (reader.isFloat()) {
+		value = reader.toFloat();
+	}
+	else if (reader.isFloat16()) {
+		value = reader.toFloat16();
+	}
+
+	skip();
+	return value;
+}
+
+bool CborReader::readBool()
+{
+	bool value = reader.isBool() && reader.toBool();
+	skip();
+	return value;
+}
+
+QJsonValue CborReader::readJsonValue()
+{
+	return QCborValue::fromCbor(reader).toJsonValue();
+}
+
+void CborReader::skip()
+{
+	if (!hasError()) {
+		reader.next();
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <QByteArray>
+#include <QCborStreamReader>
+#include <QJsonValue>
+#include <QString>
+#include <functional>
+
+/** Reads a CBOR document element by element, without building the intermediate tree of values */
+class CborReader
+{
+	public:
+		explicit CborReader(QByteArray const &data);
+
+		bool hasError() const;
+		bool isNull() const;
+
+		/** Calls `readValue` for each key of the current map, which must consume the value, with `skip` if need be */
+		void readMap(std::function<void(QString const &key)> const &readValue);
+		/** Calls `readElement` for each element of the current array, which must consume the element */
+		void readArray(std::function<void()> const &readElement);
+
+		QString readString();
+		int readInt();
+		double readDouble();
+		bool readBool();
+		/** Only meant for small values, as the whole tree of the current element is built */
+		QJsonValue readJsonValue();
+		void skip();
+
+	protected:
+		QCborStreamReader reader;
+};
@@ -0,0 +1,485 @@
+#include "ColloscopeEvaluator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include "Objective/EvenDistributionBetweenTeachersObjective.h"
+#include "Objective/MinimalNumberOfSlotsObjective.h"
+#include "Objective/NoConsecutiveCollesObjective.h"
+#include "Objective/ObjectiveComputation.h"
+#include "Objective/OnlyOneCollePerDayObjective.h"
+#include "Objective/SameSlotOnlyOnceInCycleObjective.h"
+#include "misc.h"
+#include "State.h"
+
+using std::vector;
+
+namespace {
+	/** The number of sets of `intervalSize` consecutive weeks, amongst `nbWeeks`, which contain at least two of the given weeks */
+	int countCrowdedIntervals(std::multiset<int> const &weeks, int intervalSize, int nbWeeks)
+	{
+		// Each pair of consecutive weeks is in the sets starting between `secondWeek - intervalSize + 1` and `firstWeek`,
+		// and these ranges are sorted, so they only need to be merged.
+		int nbIntervals = 0;
+		int firstUncountedStartingWeek = 0;
+		for (auto week = weeks.begin(); week != weeks.end() && std::next(week) != weeks.end(); ++week) {
+			int const firstStartingWeek = std::max({0, *std::next(week) - intervalSize + 1, firstUncountedStartingWeek});
+			int const lastStartingWeek = std::min(*week, nbWeeks - intervalSize);
+			if (firstStartingWeek <= lastStartingWeek) {
+				nbIntervals += lastStartingWeek - firstStartingWeek + 1;
+				firstUncountedStartingWeek = lastStartingWeek + 1;
+			}
+		}
+
+		return nbIntervals;
+	}
+}
+
+int ConstraintViolations::getTotal() const
+{
+	return unavailabilities + teacherClashes + trioClashes + frequencies + lunches + weeklyAvailabilities + volumes + subjectsCombinations;
+}
+
+ColloscopeEvaluator::ColloscopeEvaluator(State const &state, vector<Colle> const &colles, vector<std::unordered_map<Subject, Week>> const &subjectsCombinations):
+	state(&state),
+	colles(colles),
+	nbWeeks(state.getWeeks().size()),
+	nbTrios(state.getTrios().size()),
+	nbCollesOfTrioInSubjectInWeek(nbTrios * state.getSubjects().size() * nbWeeks, 0),
+	nbCollesOfTeacherInWeek(state.getTeachers().size() * nbWeeks, 0),
+	nbCollesOfTeacher(state.getTeachers().size(), 0),
+	nbUsedSlotsOfSubject(state.getSubjects().size(), 0),
+	nbCollesOfTeacherWithTrioInWeek(state.getTeachers().size() * nbTrios * nbWeeks, 0),
+	intervalOfTeacherWithTrio(state.getTeachers().size() * nbTrios, std::max(0, nbWeeks - 1)),
+	intervalOfTeacher(state.getTeachers().size(), std::max(0, nbWeeks - 1)),
+	intervalOfSubject(state.getSubjects().size(), std::max(0, nbWeeks - 1)),
+	sameSlotValueOfSubject(state.getSubjects().size(), 0)
+{
+	// Without any colle, every set of weeks lacks the colle of its subject, and every teacher its whole volume
+	for (auto const &subject: state.getSubjects()) {
+		violations.frequencies += nbTrios * std::max(0, nbWeeks - subject.getFrequency() + 1);
+	}
+
+	for (auto const &teacher: state.getTeachers() | std::views::filter(&Teacher::hasMeanWeeklyVolume)) {
+		violations.volumes += teacher.getTotalVolume(nbWeeks).value;
+	}
+
+	// and every trio its subjects combination
+	auto const &weeks = state.getWeeks();
+	for (auto const &combination: subjectsCombinations) {
+		auto &indexes = this->subjectsCombinations.emplace_back();
+		for (auto const &[subject, week]: combination) {
+			indexes.emplace_back(subject.getIndex(), std::ranges::find(weeks, week) - weeks.begin());
+		}
+	}
+	violations.subjectsCombinations = subjectsCombinations.empty() ? 0 : nbTrios;
+
+	for (auto const &colle: colles) {
+		apply(colle, 1);
+	}
+}
+
+vector<Colle> const &ColloscopeEvaluator::getColles() const
+{
+	return colles;
+}
+
+ConstraintViolations const &ColloscopeEvaluator::getViolations() const
+{
+	return violations;
+}
+
+/** The value the objective would have in the model, or nothing for an objective this evaluator does not know */
+std::optional<int> ColloscopeEvaluator::getObjectiveValue(Objective const *objective) const
+{
+	if (dynamic_cast<MinimalNumberOfSlotsObjective const *>(objective) != nullptr) {
+		return nbUsedSlots;
+	}
+
+	if (dynamic_cast<OnlyOneCollePerDayObjective const *>(objective) != nullptr) {
+		return nbRedundantCollesInDays;
+	}
+
+	if (dynamic_cast<NoConsecutiveCollesObjective const *>(objective) != nullptr) {
+		return nbConsecutiveColles;
+	}
+
+	if (dynamic_cast<EvenDistributionBetweenTeachersObjective const *>(objective) != nullptr) {
+		return getEvenDistributionValue();
+	}
+
+	if (dynamic_cast<SameSlotOnlyOnceInCycleObjective const *>(objective) != nullptr) {
+		int value = 0;
+		for (auto const &sameSlotValue: sameSlotValueOfSubject) {
+			value += sameSlotValue;
+		}
+
+		return value;
+	}
+
+	return std::nullopt;
+}
+
+/** The maximal value of the objective, as computed for the model from the available timeslots, or nothing for an objective this evaluator does not know */
+std::optional<int> ColloscopeEvaluator::getObjectiveMaxValue(Objective const *objective) const
+{
+	auto const &getTimeslotsOfTrioInWeek = [&](Trio const &trio, Week const &week) {
+		std::set<Timeslot> timeslots;
+		for (auto const &teacher: state->getTeachers()) {
+			std::ranges::copy(state->getAvailableTimeslots(teacher, trio, week), std::inserter(timeslots, timeslots.end()));
+		}
+
+		return timeslots;
+	};
+
+	if (dynamic_cast<MinimalNumberOfSlotsObjective const *>(objective) != nullptr) {
+		int maxValue = 0;
+		for (auto const &teacher: state->getTeachers()) {
+			maxValue += teacher.getAvailableTimeslots().size();
+		}
+
+		return maxValue;
+	}
+
+	if (dynamic_cast<OnlyOneCollePerDayObjective const *>(objective) != nullptr) {
+		int maxValue = 0;
+		for (auto const &week: state->getWeeks()) {
+			for (auto const &trio: state->getTrios()) {
+				auto const &timeslots = getTimeslotsOfTrioInWeek(trio, week);
+				for (auto const &day: Timeslot::days) {
+					maxValue += std::max(0, static_cast<int>(std::ranges::count(timeslots, day, &Timeslot::getDay)) - 1);
+				}
+			}
+		}
+
+		return maxValue;
+	}
+
+	if (dynamic_cast<NoConsecutiveCollesObjective const *>(objective) != nullptr) {
+		int maxValue = 0;
+		for (auto const &week: state->getWeeks()) {
+			for (auto const &trio: state->getTrios()) {
+				auto const &timeslots = getTimeslotsOfTrioInWeek(trio, week);
+				maxValue += std::ranges::count_if(timeslots, [&](auto const &timeslot) { return timeslots.contains(timeslot.next()); });
+			}
+		}
+
+		return maxValue;
+	}
+
+	if (dynamic_cast<EvenDistributionBetweenTeachersObjective const *>(objective) != nullptr) {
+		int const nbConsideredWeeks = std::max(0, nbWeeks - 1);
+		int const nbTeachers = state->getTeachers().size();
+		int const nbSubjects = state->getSubjects().size();
+		return nbTeachers * nbConsideredWeeks + nbSubjects * (nbTeachers * nbConsideredWeeks + 1) * nbConsideredWeeks;
+	}
+
+	if (dynamic_cast<SameSlotOnlyOnceInCycleObjective const *>(objective) != nullptr) {
+		int maxValue = 0;
+		for (auto const &subject: state->getSubjects()) {
+			int const minIntervalSize = std::min(static_cast<int>(divideCeil(nbTrios, subject.getFrequency()) * subject.getFrequency()), nbWeeks);
+			for (Teacher const &teacher: state->getTeachersOfSubject(subject)) {
+				maxValue += static_cast<int>(teacher.getAvailableTimeslots().size()) * nbTrios * (nbWeeks - minIntervalSize + 1);
+			}
+		}
+
+		return maxValue;
+	}
+
+	return std::nullopt;
+}
+
+void ColloscopeEvaluator::setObjectiveValues(vector<ObjectiveComputation> &objectiveComputations) const
+{
+	for (auto &objectiveComputation: objectiveComputations) {
+		auto const &value = getObjectiveValue(objectiveComputation.getObjective());
+		if (value.has_value()) {
+			objectiveComputation.setValue(value.value());
+		}
+	}
+}
+
+void ColloscopeEvaluator::moveColle(int idColle, Colle const &newColle)
+{
+	apply(colles[idColle], -1);
+	colles[idColle] = newColle;
+	apply(newColle, 1);
+}
+
+void ColloscopeEvaluator::addColle(Colle const &colle)
+{
+	colles.push_back(colle);
+	apply(colle, 1);
+}
+
+/** The last colle takes the index of the removed one */
+void ColloscopeEvaluator::removeColle(int idColle)
+{
+	apply(colles[idColle], -1);
+	colles[idColle] = colles.back();
+	colles.pop_back();
+}
+
+/** Add the colle when `delta` is 1, or remove it when it is -1, each count being updated along with what depends on it */
+void ColloscopeEvaluator::apply(Colle const &colle, int delta)
+{
+	auto const &teacher = colle.getTeacher();
+	auto const &subject = colle.getSubject();
+	auto const &timeslot = colle.getTimeslot();
+	int const idTeacher = teacher.getIndex();
+	int const idSubject = subject.getIndex();
+	int const idTrio = getIndex(colle.getTrio());
+	int const idWeek = getIndex(colle.getWeek());
+	int const frequency = subject.getFrequency();
+
+	auto const &updateCount = [&](int &count, int &total, auto const &getContribution) {
+		total -= getContribution(count);
+		count += delta;
+		total += getContribution(count);
+	};
+	auto const &getNbExtraColles = [](int nbColles) { return std::max(0, nbColles - 1); };
+
+	if (!teacher.isAvailableAtTimeslot(timeslot) || !state->getAvailableTimeslots(colle.getTrio(), colle.getWeek()).contains(timeslot)) {
+		violations.unavailabilities += delta;
+	}
+
+	updateCount(nbCollesOfTeacherAtTimeslotInWeek[{idTeacher, idWeek, timeslot}], violations.teacherClashes, getNbExtraColles);
+	updateCount(nbCollesOfTrioInDayOfWeek[{idTrio, idWeek, timeslot.getDay()}], nbRedundantCollesInDays, getNbExtraColles);
+
+	// The consecutive colles are the ones at this timeslot along with the previous or the next one
+	auto &nbCollesOfTrio = nbCollesOfTrioAtTimeslotInWeek[{idTrio, idWeek, timeslot}];
+	auto const &getNbConsecutiveColles = [&]() {
+		auto const &hasColle = [&](Timeslot const &otherTimeslot) {
+			auto const &nbColles = nbCollesOfTrioAtTimeslotInWeek.find({idTrio, idWeek, otherTimeslot});
+			return nbColles != nbCollesOfTrioAtTimeslotInWeek.end() && nbColles->second > 0;
+		};
+
+		if (nbCollesOfTrio == 0) {
+			return 0;
+		}
+
+		return static_cast<int>(hasColle(Timeslot(timeslot.getDay(), timeslot.getHour() - 1))) + static_cast<int>(hasColle(timeslot.next()));
+	};
+	nbConsecutiveColles -= getNbConsecutiveColles();
+	updateCount(nbCollesOfTrio, violations.trioClashes, getNbExtraColles);
+	nbConsecutiveColles += getNbConsecutiveColles();
+
+	if (isDuringLunchTime(timeslot)) {
+		auto const &availableTimeslots = state->getAvailableTimeslots(colle.getTrio(), colle.getWeek());
+		int const nbAvailableLunchTimeslots = std::ranges::count_if(availableTimeslots, [&](auto const &availableTimeslot) {
+			return availableTimeslot.getDay() == timeslot.getDay() && isDuringLunchTime(availableTimeslot);
+		});
+
+		updateCount(nbLunchCollesOfTrioInDayOfWeek[{idTrio, idWeek, timeslot.getDay()}], violations.lunches, [&](int nbColles) {
+			return nbAvailableLunchTimeslots > 0 ? std::max(0, nbColles - nbAvailableLunchTimeslots + 1) : 0;
+		});
+	}
+
+	// Only the sets of weeks containing the week of the colle change
+	auto const &getFrequencyViolations = [&]() {
+		int nbViolations = 0;
+		for (int idStartingWeek = std::max(0, idWeek - frequency + 1); idStartingWeek <= std::min(idWeek, nbWeeks - frequency); ++idStartingWeek) {
+			int nbColles = 0;
+			for (int idOtherWeek = idStartingWeek; idOtherWeek < idStartingWeek + frequency; ++idOtherWeek) {
+				nbColles += nbCollesOfTrioInSubjectInWeek[(idTrio * state->getSubjects().size() + idSubject) * nbWeeks + idOtherWeek];
+			}
+
+			nbViolations += std::abs(nbColles - 1);
+		}
+
+		return nbViolations;
+	};
+	// The combinations only give the weeks of the subjects amongst the first `frequency` ones
+	bool const isInSubjectsCombinations = !subjectsCombinations.empty() && idWeek < frequency;
+	violations.frequencies -= getFrequencyViolations();
+	violations.subjectsCombinations -= isInSubjectsCombinations && isFollowingNoSubjectsCombination(idTrio) ? 1 : 0;
+	nbCollesOfTrioInSubjectInWeek[(idTrio * state->getSubjects().size() + idSubject) * nbWeeks + idWeek] += delta;
+	violations.frequencies += getFrequencyViolations();
+	violations.subjectsCombinations += isInSubjectsCombinations && isFollowingNoSubjectsCombination(idTrio) ? 1 : 0;
+
+	int const weeklyAvailabilityFrequency = teacher.getWeeklyAvailabilityFrequency();
+	auto const &getWeeklyAvailabilityViolations = [&]() {
+		if (weeklyAvailabilityFrequency <= 1) {
+			return 0;
+		}
+
+		int nbViolations = 0;
+		for (int idStartingWeek = std::max(0, idWeek - weeklyAvailabilityFrequency + 1); idStartingWeek <= std::min(idWeek, nbWeeks - weeklyAvailabilityFrequency); ++idStartingWeek) {
+			int nbWeeksWithColles = 0;
+			for (int idOtherWeek = idStartingWeek; idOtherWeek < idStartingWeek + weeklyAvailabilityFrequency; ++idOtherWeek) {
+				nbWeeksWithColles += nbCollesOfTeacherInWeek[idTeacher * nbWeeks + idOtherWeek] > 0 ? 1 : 0;
+			}
+
+			nbViolations += std::max(0, nbWeeksWithColles - 1);
+		}
+
+		return nbViolations;
+	};
+	violations.weeklyAvailabilities -= getWeeklyAvailabilityViolations();
+	nbCollesOfTeacherInWeek[idTeacher * nbWeeks + idWeek] += delta;
+	violations.weeklyAvailabilities += getWeeklyAvailabilityViolations();
+
+	updateCount(nbCollesOfTeacher[idTeacher], violations.volumes, [&](int nbColles) {
+		if (!teacher.hasMeanWeeklyVolume()) {
+			return 0;
+		}
+
+		auto const &totalVolume = teacher.getTotalVolume(nbWeeks);
+		int const maxNbColles = totalVolume.isExact ? totalVolume.value : totalVolume.value + 1;
+		return std::max({0, totalVolume.value - nbColles, nbColles - maxNbColles});
+	});
+
+	// The interval of the same slot objective depends on the number of slots used by the subject
+	auto const &oldSameSlotIntervalSize = getSameSlotIntervalSize(idSubject);
+	auto &nbCollesOfTeacherAtSlot = nbCollesOfTeacherAtTimeslot[{idTeacher, timeslot}];
+	int const wasSlotUsed = nbCollesOfTeacherAtSlot > 0 ? 1 : 0;
+	nbCollesOfTeacherAtSlot += delta;
+	int const isSlotUsed = nbCollesOfTeacherAtSlot > 0 ? 1 : 0;
+	nbUsedSlots += isSlotUsed - wasSlotUsed;
+	nbUsedSlotsOfSubject[idSubject] += isSlotUsed - wasSlotUsed;
+
+	std::tuple<int, Timeslot, int> const sameSlotKey = {idTeacher, timeslot, idTrio};
+	auto const &newSameSlotIntervalSize = getSameSlotIntervalSize(idSubject);
+	if (oldSameSlotIntervalSize == newSameSlotIntervalSize) {
+		sameSlotValueOfSubject[idSubject] -= getSameSlotValue(sameSlotKey, newSameSlotIntervalSize);
+	}
+
+	auto &weeksOfSameSlot = weeksOfTrioWithTeacherAtTimeslot[sameSlotKey];
+	if (delta > 0) {
+		weeksOfSameSlot.insert(idWeek);
+	}
+	else {
+		weeksOfSameSlot.erase(weeksOfSameSlot.find(idWeek));
+	}
+
+	if (oldSameSlotIntervalSize == newSameSlotIntervalSize) {
+		sameSlotValueOfSubject[idSubject] += getSameSlotValue(sameSlotKey, newSameSlotIntervalSize);
+	}
+	else {
+		sameSlotValueOfSubject[idSubject] = getSameSlotValue(idSubject);
+	}
+
+	nbCollesOfTeacherWithTrioInWeek[(idTeacher * nbTrios + idTrio) * nbWeeks + idWeek] += delta;
+	updateEvenDistribution(idTeacher, idTrio);
+}
+
+/** As in the model, a trio follows a combination when it has exactly one colle of each subject in the week given by the combination */
+bool ColloscopeEvaluator::isFollowingNoSubjectsCombination(int idTrio) const
+{
+	int const nbSubjects = state->getSubjects().size();
+	return std::ranges::none_of(subjectsCombinations, [&](auto const &combination) {
+		return std::ranges::all_of(combination, [&](auto const &subjectWeek) {
+			return nbCollesOfTrioInSubjectInWeek[(idTrio * nbSubjects + subjectWeek.first) * nbWeeks + subjectWeek.second] == 1;
+		});
+	});
+}
+
+/** As in the model, the last week is not taken into account, and the interval is the number of considered weeks when there is no constraint */
+void ColloscopeEvaluator::updateEvenDistribution(int idTeacher, int idTrio)
+{
+	int const nbConsideredWeeks = std::max(0, nbWeeks - 1);
+
+	int interval = nbConsideredWeeks;
+	std::optional<int> idLastWeek;
+	for (int idWeek = 0; idWeek < nbConsideredWeeks; ++idWeek) {
+		if (nbCollesOfTeacherWithTrioInWeek[(idTeacher * nbTrios + idTrio) * nbWeeks + idWeek] > 0) {
+			if (idLastWeek.has_value()) {
+				interval = std::min(interval, idWeek - idLastWeek.value() - 1);
+			}
+
+			idLastWeek = idWeek;
+		}
+	}
+	intervalOfTeacherWithTrio[idTeacher * nbTrios + idTrio] = interval;
+
+	auto const &intervalsOfTeacher = intervalOfTeacherWithTrio | std::views::drop(idTeacher * nbTrios) | std::views::take(nbTrios);
+	intervalOfTeacher[idTeacher] = nbTrios > 0 ? std::ranges::min(intervalsOfTeacher) : nbConsideredWeeks;
+
+	auto const &subject = state->getTeachers()[idTeacher].getSubject();
+	intervalOfSubject[subject.getIndex()] = nbConsideredWeeks;
+	for (Teacher const &teacher: state->getTeachersOfSubject(subject)) {
+		intervalOfSubject[subject.getIndex()] = std::min(intervalOfSubject[subject.getIndex()], intervalOfTeacher[teacher.getIndex()]);
+	}
+}
+
+/** The minimal interval of each subject is more important than the ones of its teachers */
+int ColloscopeEvaluator::getEvenDistributionValue() const
+{
+	int const nbConsideredWeeks = std::max(0, nbWeeks - 1);
+	int const factor = state->getTeachers().size() * nbConsideredWeeks + 1;
+
+	int value = 0;
+	for (auto const &interval: intervalOfTeacher) {
+		value += nbConsideredWeeks - interval;
+	}
+
+	for (auto const &interval: intervalOfSubject) {
+		value += factor * (nbConsideredWeeks - interval);
+	}
+
+	return value;
+}
+
+/** As in the model, the number of slots of the subject times its frequency, bounded by the number of weeks, or nothing when it is too small */
+std::optional<int> ColloscopeEvaluator::getSameSlotIntervalSize(int idSubject) const
+{
+	int const frequency = state->getSubjects()[idSubject].getFrequency();
+	int const minIntervalSize = std::min(static_cast<int>(divideCeil(nbTrios, frequency) * frequency), nbWeeks);
+	int const intervalSize = nbUsedSlotsOfSubject[idSubject] * frequency;
+
+	if (intervalSize >= nbWeeks) {
+		return nbWeeks;
+	}
+
+	if (intervalSize >= minIntervalSize) {
+		return intervalSize;
+	}
+
+	return std::nullopt;
+}
+
+int ColloscopeEvaluator::getSameSlotValue(int idSubject) const
+{
+	auto const &intervalSize = getSameSlotIntervalSize(idSubject);
+	if (!intervalSize.has_value()) {
+		return 0;
+	}
+
+	int value = 0;
+	for (Teacher const &teacher: state->getTeachersOfSubject(state->getSubjects()[idSubject])) {
+		std::tuple<int, Timeslot, int> const firstKey = {teacher.getIndex(), Timeslot(Day::Monday, std::numeric_limits<int>::min()), std::numeric_limits<int>::min()};
+		for (auto entry = weeksOfTrioWithTeacherAtTimeslot.lower_bound(firstKey); entry != weeksOfTrioWithTeacherAtTimeslot.end() && std::get<0>(entry->first) == teacher.getIndex(); ++entry) {
+			value += countCrowdedIntervals(entry->second, intervalSize.value(), nbWeeks);
+		}
+	}
+
+	return value;
+}
+
+int ColloscopeEvaluator::getSameSlotValue(std::tuple<int, Timeslot, int> const &key, std::optional<int> intervalSize) const
+{
+	auto const &weeks = weeksOfTrioWithTeacherAtTimeslot.find(key);
+	if (!intervalSize.has_value() || weeks == weeksOfTrioWithTeacherAtTimeslot.end()) {
+		return 0;
+	}
+
+	return countCrowdedIntervals(weeks->second, intervalSize.value(), nbWeeks);
+}
+
+int ColloscopeEvaluator::getIndex(Trio const &trio) const
+{
+	return &trio - state->getTrios().data();
+}
+
+int ColloscopeEvaluator::getIndex(Week const &week) const
+{
+	return &week - state->getWeeks().data();
+}
+
+bool ColloscopeEvaluator::isDuringLunchTime(Timeslot const &timeslot) const
+{
+	auto const &lunchTimeRange = state->getLunchTimeRange();
+	return timeslot.getHour() >= lunchTimeRange.first && timeslot.getHour() < lunchTimeRange.second;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Colle.h"
+#include "Subject.h"
+#include "Timeslot.h"
+#include "Week.h"
+
+class Objective;
+class ObjectiveComputation;
+class State;
+
+/** How many times each hard constraint of the model is broken */
+struct ConstraintViolations {
+	/** Colles outside of the available timeslots of their teacher or of their trio */
+	int unavailabilities = 0;
+
+	/** Extra colles of a teacher, or of a trio, at the same time */
+	int teacherClashes = 0;
+	int trioClashes = 0;
+
+	/** Difference to one colle of a subject for each trio and each set of `frequency` consecutive weeks */
+	int frequencies = 0;
+
+	/** Missing free timeslots for a trio to eat lunch in a day */
+	int lunches = 0;
+
+	/** Extra weeks with colles of a teacher in each set of `weeklyAvailabilityFrequency` consecutive weeks */
+	int weeklyAvailabilities = 0;
+
+	/** Difference between the number of colles of a teacher and its total volume */
+	int volumes = 0;
+
+	/** Trios whose colles in the first weeks follow none of the subjects combinations */
+	int subjectsCombinations = 0;
+
+	int getTotal() const;
+};
+
+/**
+ * Compute the constraint violations and the objective values of a colloscope without any model,
+ * and keep them up to date when a colle is moved, by only updating what the colle is part of.
+ * The colles must refer to the teachers, trios and weeks of the state.
+ * The regular number of subjects each week is only checked when the subjects combinations allowed by the model are given.
+ */
+class ColloscopeEvaluator
+{
+	public:
+		ColloscopeEvaluator(State const &state, std::vector<Colle> const &colles, std::vector<std::unordered_map<Subject, Week>> const &subjectsCombinations = {});
+		ColloscopeEvaluator(State const &&state, std::vector<Colle> const &colles, std::vector<std::unordered_map<Subject, Week>> const &subjectsCombinations = {}) = delete;
+
+		std::vector<Colle> const &getColles() const;
+		ConstraintViolations const &getViolations() const;
+		std::optional<int> getObjectiveValue(Objective const *objective) const;
+		std::optional<int> getObjectiveMaxValue(Objective const *objective) const;
+		void setObjectiveValues(std::vector<ObjectiveComputation> &objectiveComputations) const;
+
+		void moveColle(int idColle, Colle const &newColle);
+		void addColle(Colle const &colle);
+		void removeColle(int idColle);
+
+	protected:
+		State const *state;
+		std::vector<Colle> colles;
+		int nbWeeks;
+		int nbTrios;
+
+		/** The index of the week of each subject in each combination */
+		std::vector<std::vector<std::pair<int, int>>> subjectsCombinations;
+
+		ConstraintViolations violations;
+		std::map<std::tuple<int, int, Timeslot>, int> nbCollesOfTeacherAtTimeslotInWeek;
+		std::map<std::tuple<int, int, Timeslot>, int> nbCollesOfTrioAtTimeslotInWeek;
+		std::map<std::tuple<int, int, Day>, int> nbCollesOfTrioInDayOfWeek;
+		std::map<std::tuple<int, int, Day>, int> nbLunchCollesOfTrioInDayOfWeek;
+		std::vector<int> nbCollesOfTrioInSubjectInWeek;
+		std::vector<int> nbCollesOfTeacherInWeek;
+		std::vector<int> nbCollesOfTeacher;
+
+		/** Minimal number of slots */
+		std::map<std::pair<int, Timeslot>, int> nbCollesOfTeacherAtTimeslot;
+		std::vector<int> nbUsedSlotsOfSubject;
+		int nbUsedSlots = 0;
+
+		/** Only one colle per day */
+		int nbRedundantCollesInDays = 0;
+
+		/** No consecutive colles */
+		int nbConsecutiveColles = 0;
+
+		/** Even distribution between teachers, the intervals being the minimal number of weeks between two colles of a trio with a teacher */
+		std::vector<int> nbCollesOfTeacherWithTrioInWeek;
+		std::vector<int> intervalOfTeacherWithTrio;
+		std::vector<int> intervalOfTeacher;
+		std::vector<int> intervalOfSubject;
+
+		/** Same slot only once in cycle */
+		std::map<std::tuple<int, Timeslot, int>, std::multiset<int>> weeksOfTrioWithTeacherAtTimeslot;
+		std::vector<int> sameSlotValueOfSubject;
+
+		void apply(Colle const &colle, int delta);
+		bool isFollowingNoSubjectsCombination(int idTrio) const;
+		void updateEvenDistribution(int idTeacher, int idTrio);
+		int getEvenDistributionValue() const;
+		std::optional<int> getSameSlotIntervalSize(int idSubject) const;
+		int getSameSlotValue(int idSubject) const;
+		int getSameSlotValue(std::tuple<int, Timeslot, int> const &key, std::optional<int> intervalSize) const;
+
+		int getIndex(Trio const &trio) const;
+		int getIndex(Week const &week) const;
+		bool isDuringLunchTime(Timeslot const &timeslot) const;
+};
@@ -0,0 +1,200 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <ortools/sat/cp_model.h>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+#include <atomic>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "Objective/Objective.h"
+#include "Objective/ObjectiveComputation.h"
+#include "ColloscopeEvaluator.h"
+#include "JsonStates.test.h"
+#include "Solver.h"
+#include "State.h"
+#include "Subject.h"
+#include "Teacher.h"
+#include "Trio.h"
+#include "Week.h"
+
+namespace {
+	/** Maths every week, on Monday for both trios, and physics every other week, on Wednesday */
+	std::vector<Colle> getValidColles(State const &state)
+	{
+		auto const &maths = state.getTeachers()[0];
+		auto const &physics = state.getTeachers()[1];
+		auto const &trios = state.getTrios();
+
+		std::vector<Colle> colles;
+		for (int idWeek = 0; idWeek < 4; ++idWeek) {
+			auto const &week = state.getWeeks()[idWeek];
+			colles.emplace_back(maths, Timeslot(Day::Monday, 10), trios[0], week);
+			colles.emplace_back(maths, Timeslot(Day::Monday, 11), trios[1], week);
+			colles.emplace_back(physics, Timeslot(Day::Wednesday, 16), trios[idWeek % 2], week);
+		}
+
+		return colles;
+	}
+
+	int getObjectiveValue(State const &state, ColloscopeEvaluator const &evaluator, QString const &name)
+	{
+		for (auto const &objective: state.getObjectives()) {
+			if (objective->getName() == name) {
+				return evaluator.getObjectiveValue(objective).value();
+			}
+		}
+
+		FAIL("Unknown objective " << name.toStdString());
+		return 0;
+	}
+}
+
+TEST_CASE("ColloscopeEvaluator") {
+	State state;
+	state.import(getSmallJsonState());
+	ColloscopeEvaluator evaluator(state, getValidColles(state));
+
+	REQUIRE(evaluator.getViolations().getTotal() == 0);
+	REQUIRE(getObjectiveValue(state, evaluator, "Minimal number of slots") == 3);
+	REQUIRE(getObjectiveValue(state, evaluator, "Only one colle per day") == 0);
+	REQUIRE(getObjectiveValue(state, evaluator, "No consecutive colles") == 0);
+	REQUIRE(getObjectiveValue(state, evaluator, "Even distribution between teachers") == 40);
+	REQUIRE(getObjectiveValue(state, evaluator, "Same slot only once in cycle") == 6);
+
+	SECTION("without a colle") {
+		auto colles = getValidColles(state);
+		colles.pop_back();
+		ColloscopeEvaluator incompleteEvaluator(state, colles);
+
+		REQUIRE(incompleteEvaluator.getViolations().frequencies == 1);
+		REQUIRE(incompleteEvaluator.getViolations().getTotal() == 1);
+	}
+}
+
+TEST_CASE("ColloscopeEvaluator::moveColle") {
+	State state;
+	state.import(getSmallJsonState());
+	auto colles = getValidColles(state);
+	ColloscopeEvaluator evaluator(state, colles);
+
+	// The physics colle of the first trio in the first week is moved right after its maths colle, then onto the one of the second trio
+	auto const &moves = {
+		Colle(state.getTeachers()[1], Timeslot(Day::Monday, 11), state.getTrios()[0], state.getWeeks()[0]),
+		Colle(state.getTeachers()[1], Timeslot(Day::Monday, 11), state.getTrios()[1], state.getWeeks()[0]),
+	};
+	for (auto const &move: moves) {
+		evaluator.moveColle(2, move);
+		colles[2] = move;
+		ColloscopeEvaluator freshEvaluator(state, colles);
+
+		REQUIRE(evaluator.getViolations().unavailabilities == freshEvaluator.getViolations().unavailabilities);
+		REQUIRE(evaluator.getViolations().teacherClashes == freshEvaluator.getViolations().teacherClashes);
+		REQUIRE(evaluator.getViolations().trioClashes == freshEvaluator.getViolations().trioClashes);
+		REQUIRE(evaluator.getViolations().frequencies == freshEvaluator.getViolations().frequencies);
+		REQUIRE(evaluator.getViolations().lunches == freshEvaluator.getViolations().lunches);
+		REQUIRE(evaluator.getViolations().weeklyAvailabilities == freshEvaluator.getViolations().weeklyAvailabilities);
+		REQUIRE(evaluator.getViolations().volumes == freshEvaluator.getViolations().volumes);
+		for (auto const &objective: state.getObjectives()) {
+			REQUIRE(evaluator.getObjectiveValue(objective) == freshEvaluator.getObjectiveValue(objective));
+		}
+	}
+
+	REQUIRE(getObjectiveValue(state, evaluator, "Minimal number of slots") == 4);
+	REQUIRE(evaluator.getViolations().trioClashes == 1);
+	REQUIRE(evaluator.getViolations().frequencies > 0);
+}
+
+TEST_CASE("ColloscopeEvaluator::addColle and ColloscopeEvaluator::removeColle") {
+	State state;
+	state.import(getSmallJsonState());
+	auto const &subjects = state.getSubjects();
+	auto const &weeks = state.getWeeks();
+	std::vector<std::unordered_map<Subject, Week>> const subjectsCombinations = {
+		{{subjects[0], weeks[0]}, {subjects[1], weeks[0]}},
+		{{subjects[0], weeks[0]}, {subjects[1], weeks[1]}},
+	};
+	auto const &colles = getValidColles(state);
+	ColloscopeEvaluator evaluator(state, colles, subjectsCombinations);
+	REQUIRE(evaluator.getViolations().getTotal() == 0);
+
+	// The maths colle of the first trio in the first week is removed, then added back
+	evaluator.removeColle(0);
+	REQUIRE(evaluator.getColles().size() == colles.size() - 1);
+	REQUIRE(evaluator.getViolations().subjectsCombinations == 1);
+	REQUIRE(evaluator.getViolations().frequencies == 1);
+
+	ColloscopeEvaluator freshEvaluator(state, evaluator.getColles(), subjectsCombinations);
+	REQUIRE(evaluator.getViolations().getTotal() == freshEvaluator.getViolations().getTotal());
+	for (auto const &objective: state.getObjectives()) {
+		REQUIRE(evaluator.getObjectiveValue(objective) == freshEvaluator.getObjectiveValue(objective));
+	}
+
+	evaluator.addColle(colles[0]);
+	REQUIRE(evaluator.getColles().size() == colles.size());
+	REQUIRE(evaluator.getViolations().getTotal() == 0);
+	for (auto const &objective: state.getObjectives()) {
+		REQUIRE(evaluator.getObjectiveValue(objective) == ColloscopeEvaluator(state, colles).getObjectiveValue(objective));
+	}
+}
+
+TEST_CASE("ColloscopeEvaluator matches the model") {
+	using operations_research::sat::CpModelBuilder;
+	using operations_research::sat::CpSolverStatus;
+	using operations_research::sat::LinearExpr;
+
+	State state;
+	state.import(getSmallJsonState());
+	auto colles = getValidColles(state);
+
+	// The physics colles of the first trio are optionally moved right after its maths ones, so that more objectives are not zero
+	if (GENERATE(false, true)) {
+		for (int idColle: {2, 8}) {
+			colles[idColle] = Colle(state.getTeachers()[1], Timeslot(Day::Monday, 11), state.getTrios()[0], colles[idColle].getWeek());
+		}
+	}
+
+	std::set<std::tuple<int, int, int, Timeslot>> colleKeys;
+	for (auto const &colle: colles) {
+		colleKeys.emplace(colle.getTeacher().getIndex(), colle.getTrio().getId(), colle.getWeek().getId(), colle.getTimeslot());
+	}
+
+	// Every colle variable is fixed, and minimising the objectives sets their auxiliary variables to the values they have in a search
+	CpModelBuilder modelBuilder;
+	SolverVar isTrioWithTeacherAtTimeslotInWeek;
+	for (auto const &teacher: state.getTeachers()) {
+		for (auto const &trio: state.getTrios()) {
+			for (auto const &week: state.getWeeks()) {
+				for (auto const &timeslot: state.getAvailableTimeslots(teacher, trio, week)) {
+					auto const &var = modelBuilder.NewBoolVar();
+					modelBuilder.FixVariable(var, colleKeys.contains({teacher.getIndex(), trio.getId(), week.getId(), timeslot}));
+					isTrioWithTeacherAtTimeslotInWeek[trio][teacher][timeslot][week] = var;
+				}
+			}
+		}
+	}
+
+	std::atomic<bool> const shouldComputationBeStopped = false;
+	std::vector<ObjectiveComputation> objectiveComputations;
+	LinearExpr objectivesSum;
+	for (auto const &objective: state.getObjectives()) {
+		auto const &objectiveComputation = objectiveComputations.emplace_back(objective->compute(&state, isTrioWithTeacherAtTimeslotInWeek, modelBuilder, shouldComputationBeStopped));
+		objectivesSum += objectiveComputation.getExpression();
+	}
+	modelBuilder.Minimize(objectivesSum);
+
+	auto const &response = operations_research::sat::Solve(modelBuilder.Build());
+	REQUIRE(response.status() == CpSolverStatus::OPTIMAL);
+
+	ColloscopeEvaluator evaluator(state, colles);
+	REQUIRE(evaluator.getViolations().getTotal() == 0);
+	for (auto &objectiveComputation: objectiveComputations) {
+		INFO(objectiveComputation.getObjective()->getName().toStdString());
+		objectiveComputation.evaluate(response);
+		REQUIRE(evaluator.getObjectiveValue(objectiveComputation.getObjective()) == objectiveComputation.getValue());
+		REQUIRE(evaluator.getObjectiveMaxValue(objectiveComputation.getObjective()) == objectiveComputation.getMaxValue());
+	}
+}
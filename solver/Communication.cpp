@@ -2,17 +2,27 @@
 
 #include <QFutureWatcher>
 #include <QJsonArray>
+#include <QJsonObject>
 #include <QtConcurrent>
+#include <chrono>
 #include "Objective/ObjectiveComputation.h"
+#include "SearchStatistics.h"
+#include "SolutionStore.h"
 #include "Solver.h"
 #include "State.h"
 
-Communication::Communication(State &state, Solver &solver, QObject *parent):
-    QObject(parent), state(&state), solver(&solver)
+Communication::Communication(State &state, Solver &solver, SolutionStore &solutionStore, QObject *parent):
+    QObject(parent), state(&state), solver(&solver), solutionStore(&solutionStore)
 {
+	connect(&progressTimer, &QTimer::timeout, this, [this]() {
+		emit progressReported(this->solver->getStatistics().toJsonObject());
+	});
+
+	// Emitted from the thread of the computation, so the timer is stopped in its own thread through a queued connection
+	connect(this, &Communication::computationFinished, &progressTimer, &QTimer::stop);
 }
 
-void Communication::sendSolution(std::vector<ObjectiveComputation> const &objectiveComputations) const
+void Communication::sendSolution(std::vector<ObjectiveComputation> const &objectiveComputations, SearchStatistics const &statistics) const
 {
 	QJsonArray jsonColles;
 	for (auto const &colle: colles) {
@@ -24,20 +34,37 @@ void Communication::sendSolution(std::vector<ObjectiveComputation> const &object
 		jsonObjectiveComputations << objectiveComputation.toJsonObject();
 	}
 
-	emit solutionFound(jsonColles, jsonObjectiveComputations);
+	solutionStore->append(fingerprint, jsonColles, jsonObjectiveComputations);
+	emit solutionFound(jsonColles, jsonObjectiveComputations, statistics.toJsonObject());
 }
 
 /* @todo Only accepts a single computation */
 void Communication::compute(QJsonObject const &jsonState)
 {
-	state->import(jsonState);
+	if (!state->import(jsonState)) {
+		emit computationFinished(false);
+		return;
+	}
+
+	// Resume from the last solution found for the same state, even by a previous run of the application
+	fingerprint = SolutionStore::getFingerprint(jsonState);
+	auto const &lastColles = solutionStore->getLastColles(fingerprint);
+	if (lastColles.has_value()) {
+		solver->setPreviousColles(lastColles.value());
+	}
+
+	auto const progressInterval = state->getSolverParameters().getProgressInterval();
+	if (progressInterval > 0) {
+		progressTimer.start(std::chrono::milliseconds(static_cast<int>(1000 * progressInterval)));
+	}
 
+	solver->prepareComputation();
 	QFutureWatcher<void> watcher;
 	watcher.setFuture(QtConcurrent::run([&]() {
 		bool success = solver->compute(
-			[&](auto const &newColles, auto const &objectiveComputations) {
+			[&](auto const &newColles, auto const &objectiveComputations, auto const &statistics) {
 				colles = newColles;
-				sendSolution(objectiveComputations);
+				sendSolution(objectiveComputations, statistics);
 			}
 		);
 		emit computationFinished(success);
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <QByteArray>
 #include <QObject>
+#include <QTimer>
 #include <vector>
 #include "Colle.h"
 
 class Objective;
 class ObjectiveComputation;
+struct SearchStatistics;
+class SolutionStore;
 class Solver;
 class State;
 
@@ -14,20 +18,24 @@ class Communication : public QObject
 	Q_OBJECT
 
 	public:
-		Communication(State &state, Solver &solver, QObject *parent = nullptr);
-		void sendSolution(std::vector<ObjectiveComputation> const &objectiveComputations) const;
+		Communication(State &state, Solver &solver, SolutionStore &solutionStore, QObject *parent = nullptr);
+		void sendSolution(std::vector<ObjectiveComputation> const &objectiveComputations, SearchStatistics const &statistics) const;
 
 	public slots:
 		void compute(QJsonObject const &jsonState);
 		void stopComputation();
 
 	signals:
-		void solutionFound(const QJsonArray &colles, const QJsonArray &objectiveComputations) const;
+		void solutionFound(const QJsonArray &colles, const QJsonArray &objectiveComputations, const QJsonObject &statistics) const;
 		void computationFinished(bool success) const;
+		void progressReported(const QJsonObject &statistics) const;
 
 	protected:
 		State* state;
 		Solver* solver;
+		SolutionStore* solutionStore;
+		QByteArray fingerprint;
+		QTimer progressTimer;
 
 		std::vector<Colle> colles;
 };
@@ -0,0 +1,145 @@
+#include "GreedyHeuristic.h"
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <set>
+#include <tuple>
+#include <utility>
+#include "State.h"
+
+using std::unordered_map;
+using std::vector;
+
+GreedyHeuristic::GreedyHeuristic(State const &state): state(&state)
+{
+}
+
+/**
+ * The trios follow the given subjects combinations in turn, so that the colles of each subject are spread over its weeks.
+ * In periodic mode, the colles of the first cycle are repeated for the following weeks.
+ */
+vector<Colle> GreedyHeuristic::compute(vector<unordered_map<Subject, Week>> const &subjectsCombinations, int nbModelledWeeks) const
+{
+	auto const &weeks = state->getWeeks();
+	auto const &trios = state->getTrios();
+	int const nbWeeks = weeks.size();
+	if (subjectsCombinations.empty() || nbWeeks == 0) {
+		return {};
+	}
+
+	auto const &getPhase = [&](auto const &trio, Subject const &subject) {
+		auto const idTrio = &trio - trios.data();
+		auto const &startingWeek = subjectsCombinations[idTrio % subjectsCombinations.size()].at(subject);
+		return static_cast<int>(std::ranges::find(weeks, startingWeek) - weeks.begin());
+	};
+
+	auto const &lunchTimeRange = state->getLunchTimeRange();
+	auto const &isDuringLunchTime = [&](Timeslot const &timeslot) {
+		return timeslot.getHour() >= lunchTimeRange.first && timeslot.getHour() < lunchTimeRange.second;
+	};
+
+	vector<int> nbCollesOfTeacher(state->getTeachers().size(), 0);
+	vector<std::optional<int>> lastWeekOfTeacher(state->getTeachers().size());
+	std::set<std::pair<int, Timeslot>> usedSlots;
+
+	vector<Colle> colles;
+	for (int idWeek = 0; idWeek < nbModelledWeeks; ++idWeek) {
+		auto const &week = weeks[idWeek];
+		std::set<std::pair<int, Timeslot>> busyTeachers;
+		std::set<std::pair<int, Timeslot>> busyTrios;
+		std::set<std::pair<int, Day>> busyTrioDays;
+
+		std::map<std::pair<int, Day>, int> nbFreeLunchTimeslots;
+		for (auto const &trio: trios) {
+			for (auto const &timeslot: state->getAvailableTimeslots(trio, week)) {
+				if (isDuringLunchTime(timeslot)) {
+					++nbFreeLunchTimeslots[{trio.getId(), timeslot.getDay()}];
+				}
+			}
+		}
+
+		// The first trios get the best choices, so the order changes every week
+		for (int idTrioOffset = 0; idTrioOffset < trios.size(); ++idTrioOffset) {
+			auto const &trio = trios[(idWeek + idTrioOffset) % trios.size()];
+
+			for (auto const &subject: state->getSubjects()) {
+				if (idWeek % subject.getFrequency() != getPhase(trio, subject)) {
+					continue;
+				}
+
+				// The teachers the most behind their volume come first, then the slots already used, then the days without any other colle
+				std::optional<std::tuple<double, bool, bool>> bestScore;
+				std::optional<Colle> bestColle;
+				for (Teacher const &teacher: state->getTeachersOfSubject(subject)) {
+					auto const &lastWeek = lastWeekOfTeacher[teacher.getIndex()];
+					if (lastWeek.has_value() && *lastWeek != idWeek && idWeek - *lastWeek < teacher.getWeeklyAvailabilityFrequency()) {
+						continue;
+					}
+
+					double expectedNbColles = 0;
+					if (teacher.hasMeanWeeklyVolume()) {
+						// Only the modelled weeks are filled here, the other cycles being copies of them
+						auto const &totalVolume = teacher.getTotalVolume(nbModelledWeeks);
+						if (nbCollesOfTeacher[teacher.getIndex()] >= totalVolume.value + (totalVolume.isExact ? 0 : 1)) {
+							continue;
+						}
+
+						expectedNbColles = static_cast<double>(totalVolume.value) * (idWeek + 1) / nbModelledWeeks;
+					}
+
+					for (auto const &timeslot: state->getAvailableTimeslots(teacher, trio, week)) {
+						if (busyTeachers.contains({teacher.getIndex(), timeslot}) || busyTrios.contains({trio.getId(), timeslot})) {
+							continue;
+						}
+
+						if (isDuringLunchTime(timeslot) && nbFreeLunchTimeslots[{trio.getId(), timeslot.getDay()}] <= 1) {
+							continue;
+						}
+
+						std::tuple<double, bool, bool> const score = {
+							expectedNbColles - nbCollesOfTeacher[teacher.getIndex()],
+							usedSlots.contains({teacher.getIndex(), timeslot}),
+							!busyTrioDays.contains({trio.getId(), timeslot.getDay()}),
+						};
+
+						if (!bestScore.has_value() || score > *bestScore) {
+							bestScore = score;
+							bestColle.emplace(teacher, timeslot, trio, week);
+						}
+					}
+				}
+
+				if (!bestColle.has_value()) {
+					continue;
+				}
+
+				auto const &teacher = bestColle->getTeacher();
+				auto const &timeslot = bestColle->getTimeslot();
+				busyTeachers.emplace(teacher.getIndex(), timeslot);
+				busyTrios.emplace(trio.getId(), timeslot);
+				busyTrioDays.emplace(trio.getId(), timeslot.getDay());
+				usedSlots.emplace(teacher.getIndex(), timeslot);
+				if (isDuringLunchTime(timeslot)) {
+					--nbFreeLunchTimeslots[{trio.getId(), timeslot.getDay()}];
+				}
+
+				++nbCollesOfTeacher[teacher.getIndex()];
+				lastWeekOfTeacher[teacher.getIndex()] = idWeek;
+				colles.push_back(bestColle.value());
+			}
+		}
+	}
+
+	int const nbModelledColles = colles.size();
+	for (int idWeek = nbModelledWeeks; idWeek < nbWeeks; ++idWeek) {
+		for (int idColle = 0; idColle < nbModelledColles; ++idColle) {
+			auto const colle = colles[idColle];
+			if (&colle.getWeek() == &weeks[idWeek % nbModelledWeeks]) {
+				colles.emplace_back(colle.getTeacher(), colle.getTimeslot(), colle.getTrio(), weeks[idWeek]);
+			}
+		}
+	}
+
+	return colles;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include "Colle.h"
+
+class State;
+class Subject;
+class Week;
+
+/**
+ * Build a colloscope week by week, giving each trio the colles of its subjects in the first acceptable teacher and timeslot.
+ * The result respects the availabilities, the clashes, the frequencies, the lunch time and the volumes,
+ * but some colles may be missing when no acceptable teacher and timeslot is left.
+ */
+class GreedyHeuristic
+{
+	public:
+		GreedyHeuristic(State const &state);
+		GreedyHeuristic(State const &&state) = delete;
+
+		std::vector<Colle> compute(std::vector<std::unordered_map<Subject, Week>> const &subjectsCombinations, int nbModelledWeeks) const;
+
+	protected:
+		State const *state;
+};
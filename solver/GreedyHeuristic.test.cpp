@@ -0,0 +1,86 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+#include "ColloscopeEvaluator.h"
+#include "GreedyHeuristic.h"
+#include "JsonStates.test.h"
+#include "State.h"
+
+TEST_CASE("GreedyHeuristic") {
+	State state;
+	state.import(getSmallJsonState());
+	auto const &maths = state.getSubjects()[0];
+	auto const &physics = state.getSubjects()[1];
+	auto const &weeks = state.getWeeks();
+
+	// The two trios have physics in turn, as with the best subjects combinations of the solver
+	std::vector<std::unordered_map<Subject, Week>> const subjectsCombinations = {
+		{{maths, weeks[0]}, {physics, weeks[0]}},
+		{{maths, weeks[0]}, {physics, weeks[1]}},
+	};
+
+	SECTION("whole year") {
+		auto const &colles = GreedyHeuristic(state).compute(subjectsCombinations, weeks.size());
+		ColloscopeEvaluator evaluator(state, colles);
+
+		REQUIRE(colles.size() == 12);
+		REQUIRE(evaluator.getViolations().getTotal() == 0);
+	}
+
+	SECTION("periodic mode") {
+		// The colles of the first cycle of two weeks are repeated for the two following ones
+		auto const &colles = GreedyHeuristic(state).compute(subjectsCombinations, 2);
+		ColloscopeEvaluator evaluator(state, colles);
+
+		REQUIRE(colles.size() == 12);
+		REQUIRE(evaluator.getViolations().getTotal() == 0);
+	}
+}
+
+TEST_CASE("GreedyHeuristic with mean weekly volumes") {
+	// A second maths teacher takes the colles the first one has no volume for
+	auto jsonState = getSmallJsonState();
+	auto jsonTeachers = jsonState["teachers"].toArray();
+	auto jsonTeacher = jsonTeachers[0].toObject();
+	jsonTeacher["meanWeeklyVolume"] = 0.5;
+	jsonTeachers[0] = jsonTeacher;
+	jsonTeacher["id"] = "m2";
+	jsonTeacher["name"] = "M2";
+	jsonTeacher["meanWeeklyVolume"] = QJsonValue::Null;
+	jsonTeachers << jsonTeacher;
+	jsonState["teachers"] = jsonTeachers;
+
+	State state;
+	state.import(jsonState);
+	auto const &maths = state.getSubjects()[0];
+	auto const &physics = state.getSubjects()[1];
+	auto const &weeks = state.getWeeks();
+
+	std::vector<std::unordered_map<Subject, Week>> const subjectsCombinations = {
+		{{maths, weeks[0]}, {physics, weeks[0]}},
+		{{maths, weeks[0]}, {physics, weeks[1]}},
+	};
+
+	auto const getNbCollesOfFirstTeacher = [](std::vector<Colle> const &colles) {
+		return std::ranges::count_if(colles, [](Colle const &colle) { return colle.getTeacher().getId() == "m"; });
+	};
+
+	SECTION("whole year") {
+		auto const &colles = GreedyHeuristic(state).compute(subjectsCombinations, weeks.size());
+
+		REQUIRE(colles.size() == 12);
+		REQUIRE(getNbCollesOfFirstTeacher(colles) == 2);
+		REQUIRE(ColloscopeEvaluator(state, colles).getViolations().getTotal() == 0);
+	}
+
+	SECTION("periodic mode") {
+		// The volume of the first cycle is repeated, so it must be half of the yearly one
+		auto const &colles = GreedyHeuristic(state).compute(subjectsCombinations, 2);
+
+		REQUIRE(colles.size() == 12);
+		REQUIRE(getNbCollesOfFirstTeacher(colles) == 2);
+		REQUIRE(ColloscopeEvaluator(state, colles).getViolations().getTotal() == 0);
+	}
+}
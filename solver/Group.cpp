@@ -2,15 +2,15 @@
 
 #include <QJsonArray>
 #include <QJsonObject>
-#include <algorithm>
 #include "Week.h"
 
-Group::Group(QString const &id, QString const &name, std::set<Timeslot> const &availableTimeslots):
-	id(id), name(name), availableTimeslots(availableTimeslots), duration(0), nextGroup(nullptr)
+Group::Group(int index, QString const &id, QString const &name, std::set<Timeslot> const &availableTimeslots):
+	index(index), id(id), name(name), availableTimeslots(availableTimeslots), duration(0), nextGroup(nullptr)
 {
 }
 
-Group::Group(QJsonObject const &json): Group(
+Group::Group(int index, QJsonObject const &json): Group(
+	index,
 	json["id"].toString(),
 	json["name"].toString(),
 	Timeslot::getSet(json["availableTimeslots"].toArray())
@@ -24,17 +24,22 @@ void Group::setNextGroup(int newDuration, const Group &newNextGroup)
 	nextGroup = &newNextGroup;
 }
 
-void Group::setNextGroup(const QJsonObject& json, const std::vector<Group>& groups)
+void Group::setNextGroup(const QJsonObject& json, const std::unordered_map<QString, const Group*>& groupsById)
 {
 	auto const &jsonNextGroupId = json["nextGroupId"];
 	if (!jsonNextGroupId.isUndefined() && !jsonNextGroupId.isNull()) {
 		setNextGroup(
 			json["duration"].toInt(),
-			*std::ranges::find_if(groups, [&](auto const &group) { return group.getId() == jsonNextGroupId.toString(); })
+			*groupsById.at(jsonNextGroupId.toString())
 		);
 	}
 }
 
+int Group::getIndex() const
+{
+	return index;
+}
+
 const QString& Group::getId() const
 {
 	return id;
@@ -58,3 +63,17 @@ const std::set<Timeslot>& Group::getAvailableTimeslotsInWeek(const Week& week) c
 	return group->availableTimeslots;
 }
 
+bool Group::hasNextGroup() const
+{
+	return nextGroup != nullptr;
+}
+
+Group const *Group::getNextGroup() const
+{
+	return nextGroup;
+}
+
+bool Group::operator==(Group const &group) const
+{
+	return index == group.index;
+}
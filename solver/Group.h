@@ -2,6 +2,7 @@
 
 #include <QString>
 #include <set>
+#include <unordered_map>
 #include "Timeslot.h"
 
 class QJsonObject;
@@ -10,18 +11,23 @@ class Week;
 class Group
 {
 	public:
-		Group(QString const &id, QString const &name, std::set<Timeslot> const &availableTimeslots);
-		Group(QJsonObject const &json);
+		Group(int index, QString const &id, QString const &name, std::set<Timeslot> const &availableTimeslots);
+		Group(int index, QJsonObject const &json);
 		void setNextGroup(int newDuration, Group const &newNextGroup);
-		void setNextGroup(QJsonObject const &json, std::vector<Group> const &groups);
+		void setNextGroup(QJsonObject const &json, std::unordered_map<QString, Group const *> const &groupsById);
 
+		int getIndex() const;
 		QString const &getId() const;
 		QString const &getName() const;
 		std::set<Timeslot> const &getAvailableTimeslotsInWeek(Week const &week) const;
+		bool hasNextGroup() const;
+		Group const *getNextGroup() const;
 
-		bool operator==(Group const &) const = default;
+		bool operator==(Group const &group) const;
 
 	protected:
+		/** Position in the imported groups, used instead of the id for the comparisons */
+		int index;
 		QString id;
 		QString name;
 		std::set<Timeslot> availableTimeslots;
@@ -0,0 +1,274 @@
+#include "JobServer.h"
+
+#include <QHttpServer>
+#include <QHttpServerRequest>
+#include <QHttpServerResponse>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QTimer>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cstring>
+#include "Objective/ObjectiveComputation.h"
+#include "Colle.h"
+#include "SearchStatistics.h"
+
+EventStream::EventStream()
+{
+	open(QIODevice::ReadOnly);
+}
+
+void EventStream::send(QString const &event, QJsonObject const &data)
+{
+	buffer += "event: " + event.toUtf8() + "\ndata: " + QJsonDocument(data).toJson(QJsonDocument::Compact) + "\n\n";
+	emit readyRead();
+}
+
+void EventStream::finish()
+{
+	isFinished = true;
+	emit readyRead();
+	emit readChannelFinished();
+}
+
+bool EventStream::isSequential() const
+{
+	return true;
+}
+
+/** Only at its end once finished, so that the responder keeps waiting for the next events meanwhile */
+bool EventStream::atEnd() const
+{
+	return isFinished && buffer.isEmpty();
+}
+
+qint64 EventStream::bytesAvailable() const
+{
+	return buffer.size() + QIODevice::bytesAvailable();
+}
+
+qint64 EventStream::readData(char *data, qint64 maxSize)
+{
+	if (buffer.isEmpty()) {
+		return isFinished ? -1 : 0;
+	}
+
+	qint64 const size = std::min<qint64>(maxSize, buffer.size());
+	std::memcpy(data, buffer.constData(), size);
+	buffer.remove(0, size);
+	return size;
+}
+
+qint64 EventStream::writeData(char const *, qint64)
+{
+	return -1;
+}
+
+bool Job::isFinished() const
+{
+	return status != "queued" && status != "running";
+}
+
+QJsonObject Job::toJsonObject() const
+{
+	return {
+		{"id", id},
+		{"status", status},
+		{"statistics", solver.getStatistics().toJsonObject()},
+		{"colles", colles},
+		{"objectiveComputations", objectiveComputations},
+	};
+}
+
+JobServer::JobServer(QObject *parent): QObject(parent)
+{
+	threadPool.setMaxThreadCount(maxNbRunningJobs);
+}
+
+JobServer::~JobServer()
+{
+	for (auto const &[id, job]: jobs) {
+		job->solver.stopComputation();
+	}
+
+	for (auto const &[id, job]: jobs) {
+		job->future.waitForFinished();
+	}
+}
+
+void JobServer::addRoutes(QHttpServer *server)
+{
+	server->route("/jobs", QHttpServerRequest::Method::Post, [this](QHttpServerRequest const &request) {
+		return createJob(request.body());
+	});
+	server->route("/jobs/<arg>", QHttpServerRequest::Method::Get, [this](int id) {
+		return getJob(id);
+	});
+	server->route("/jobs/<arg>", QHttpServerRequest::Method::Delete, [this](int id) {
+		return cancelJob(id);
+	});
+	server->route("/jobs/<arg>/events", QHttpServerRequest::Method::Get, [this](int id, QHttpServerRequest const &, QHttpServerResponder &&responder) {
+		streamEvents(id, std::move(responder));
+	});
+}
+
+QHttpServerResponse JobServer::createJob(QByteArray const &body)
+{
+	QJsonParseError error;
+	auto const &document = QJsonDocument::fromJson(body, &error);
+	if (error.error != QJsonParseError::NoError || !document.isObject()) {
+		return getJsonResponse({{"error", "The body must be a JSON object describing the state"}}, QHttpServerResponder::StatusCode::BadRequest);
+	}
+
+	int const nbUnfinishedJobs = std::ranges::count_if(jobs, [](auto const &idAndJob) { return !idAndJob.second->isFinished(); });
+	if (nbUnfinishedJobs >= maxNbRunningJobs + maxNbQueuedJobs) {
+		return getJsonResponse({{"error", "Too many jobs are waiting, try again later"}}, QHttpServerResponder::StatusCode::ServiceUnavailable);
+	}
+
+	// The body is not trusted, but the import checks it instead of throwing or letting the solver divide by zero
+	auto newJob = std::make_unique<Job>();
+	if (!newJob->state.import(document.object())) {
+		return getJsonResponse({{"error", "The state is invalid: unknown ids, no week, a frequency which is not positive, or a forbidden subjects combination which is always there"}}, QHttpServerResponder::StatusCode::BadRequest);
+	}
+
+	newJob->id = nextId++;
+	auto &job = *jobs.emplace(newJob->id, std::move(newJob)).first->second;
+
+	// Prepared before being queued, so that a cancellation before the computation starts is not reset by it
+	job.solver.prepareComputation();
+
+	// The solutions are found in the thread of the computation, whereas the jobs and the event streams belong to the thread of the server
+	job.future = QtConcurrent::run(&threadPool, [this, &job]() {
+		QMetaObject::invokeMethod(this, [this, &job]() {
+			computationStarted(job);
+		}, Qt::QueuedConnection);
+
+		bool success = job.solver.compute(
+			[&](auto const &colles, auto const &objectiveComputations, auto const &statistics) {
+				QJsonArray jsonColles;
+				for (auto const &colle: colles) {
+					jsonColles << colle.toJsonObject();
+				}
+
+				QJsonArray jsonObjectiveComputations;
+				for (auto const &objectiveComputation: objectiveComputations) {
+					jsonObjectiveComputations << objectiveComputation.toJsonObject();
+				}
+
+				QMetaObject::invokeMethod(this, [this, &job, jsonColles, jsonObjectiveComputations, jsonStatistics = statistics.toJsonObject()]() {
+					solutionFound(job, jsonColles, jsonObjectiveComputations, jsonStatistics);
+				}, Qt::QueuedConnection);
+			}
+		);
+
+		QMetaObject::invokeMethod(this, [this, &job, success]() {
+			computationFinished(job, success);
+		}, Qt::QueuedConnection);
+	});
+
+	qDebug() << "Job" << job.id << "queued";
+	return getJsonResponse(job.toJsonObject(), QHttpServerResponder::StatusCode::Created);
+}
+
+QHttpServerResponse JobServer::getJob(int id) const
+{
+	auto const &job = jobs.find(id);
+	if (job == jobs.end()) {
+		return QHttpServerResponse(QHttpServerResponder::StatusCode::NotFound);
+	}
+
+	return getJsonResponse(job->second->toJsonObject());
+}
+
+/** The job is kept until its lifetime is over, so that its best solution can still be retrieved */
+QHttpServerResponse JobServer::cancelJob(int id)
+{
+	auto const &job = jobs.find(id);
+	if (job == jobs.end()) {
+		return QHttpServerResponse(QHttpServerResponder::StatusCode::NotFound);
+	}
+
+	if (!job->second->isFinished()) {
+		job->second->isCancelled = true;
+		job->second->solver.stopComputation();
+	}
+
+	return getJsonResponse(job->second->toJsonObject());
+}
+
+void JobServer::streamEvents(int id, QHttpServerResponder &&responder)
+{
+	auto const &job = jobs.find(id);
+	if (job == jobs.end()) {
+		return responder.write(QHttpServerResponder::StatusCode::NotFound);
+	}
+
+	// The current best solution is sent right away, so that a client does not miss the ones found before it connected
+	auto const eventStream = new EventStream();
+	if (!job->second->objectiveComputations.isEmpty()) {
+		eventStream->send("solution", {
+			{"objectiveComputations", job->second->objectiveComputations},
+			{"statistics", job->second->solver.getStatistics().toJsonObject()},
+		});
+	}
+
+	if (!job->second->isFinished()) {
+		job->second->eventStreams.emplace_back(eventStream);
+	}
+	else {
+		eventStream->send("finished", {{"status", job->second->status}});
+		eventStream->finish();
+	}
+
+	responder.write(eventStream, {
+		{"Content-Type", "text/event-stream"},
+		{"Cache-Control", "no-cache"},
+	});
+}
+
+/** A cancelled job still goes through its computation, which stops right away */
+void JobServer::computationStarted(Job &job)
+{
+	if (!job.isCancelled) {
+		job.status = "running";
+		qDebug() << "Job" << job.id << "started";
+	}
+}
+
+/** Only the objectives and the statistics are streamed, the colles being retrieved from the job when needed */
+void JobServer::solutionFound(Job &job, QJsonArray const &colles, QJsonArray const &objectiveComputations, QJsonObject const &statistics)
+{
+	job.colles = colles;
+	job.objectiveComputations = objectiveComputations;
+
+	std::erase_if(job.eventStreams, [](auto const &eventStream) { return eventStream.isNull(); });
+	for (auto const &eventStream: job.eventStreams) {
+		eventStream->send("solution", {
+			{"objectiveComputations", objectiveComputations},
+			{"statistics", statistics},
+		});
+	}
+}
+
+void JobServer::computationFinished(Job &job, bool success)
+{
+	job.status = job.isCancelled ? "cancelled" : (success ? "succeeded" : "failed");
+	qDebug() << "Job" << job.id << job.status;
+
+	for (auto const &eventStream: job.eventStreams) {
+		if (!eventStream.isNull()) {
+			eventStream->send("finished", {{"status", job.status}});
+			eventStream->finish();
+		}
+	}
+	job.eventStreams.clear();
+
+	QTimer::singleShot(finishedJobLifetime, this, [this, id = job.id]() {
+		jobs.erase(id);
+	});
+}
+
+QHttpServerResponse JobServer::getJsonResponse(QJsonObject const &json, QHttpServerResponder::StatusCode status)
+{
+	return QHttpServerResponse("application/json", QJsonDocument(json).toJson(QJsonDocument::Compact), status);
+}
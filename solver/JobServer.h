@@ -0,0 +1,107 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFuture>
+#include <QHttpServerResponder>
+#include <QIODevice>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QThreadPool>
+#include <map>
+#include <memory>
+#include <vector>
+#include "Solver.h"
+#include "State.h"
+
+class QHttpServer;
+class QHttpServerResponse;
+
+/** A never-ending response body, fed with server-sent events until it is finished */
+class EventStream : public QIODevice
+{
+	public:
+		EventStream();
+		void send(QString const &event, QJsonObject const &data);
+		void finish();
+
+		bool isSequential() const override;
+		bool atEnd() const override;
+		qint64 bytesAvailable() const override;
+
+	protected:
+		QByteArray buffer;
+		bool isFinished = false;
+
+		qint64 readData(char *data, qint64 maxSize) override;
+		qint64 writeData(char const *data, qint64 maxSize) override;
+};
+
+/** A computation started through the HTTP API, with its own state and solver, so that several ones can run at the same time */
+struct Job {
+	int id;
+	State state;
+	Solver solver{state};
+
+	/** One of "queued", "running", "succeeded", "failed" or "cancelled" */
+	QString status = "queued";
+	bool isCancelled = false;
+
+	/** The best solution found so far */
+	QJsonArray colles;
+	QJsonArray objectiveComputations;
+
+	/** Owned by the responders, which delete them once the clients are gone */
+	std::vector<QPointer<EventStream>> eventStreams;
+	QFuture<void> future;
+
+	bool isFinished() const;
+	QJsonObject toJsonObject() const;
+};
+
+/**
+ * Serves the jobs under `/jobs`:
+ * - `POST /jobs` queues a computation of the state given as body, and answers with the job,
+ *   or with 400 when the state is invalid, or with 503 when too many jobs are already waiting;
+ * - `GET /jobs/{id}` answers with the status, the statistics and the best solution of the job;
+ * - `DELETE /jobs/{id}` stops the computation of the job;
+ * - `GET /jobs/{id}/events` streams a `solution` event for each improving solution, then a `finished` one.
+ * The jobs run in a pool of their own, so that they neither starve each other nor the computations of the user interface,
+ * and are forgotten some time after they are finished.
+ */
+class JobServer : public QObject
+{
+	Q_OBJECT
+
+	public:
+		explicit JobServer(QObject *parent = nullptr);
+		virtual ~JobServer();
+		void addRoutes(QHttpServer *server);
+
+		/** Each computation already uses all the cores, so running more of them at once would only slow them all down */
+		static constexpr int maxNbRunningJobs = 2;
+		static constexpr int maxNbQueuedJobs = 16;
+
+		/** In milliseconds */
+		static constexpr int finishedJobLifetime = 60 * 60 * 1000;
+
+	protected:
+		std::map<int, std::unique_ptr<Job>> jobs;
+
+		/** Declared after the jobs, so that it is destroyed first, once their computations are over */
+		QThreadPool threadPool;
+		int nextId = 1;
+
+		QHttpServerResponse createJob(QByteArray const &body);
+		QHttpServerResponse getJob(int id) const;
+		QHttpServerResponse cancelJob(int id);
+		void streamEvents(int id, QHttpServerResponder &&responder);
+
+		void computationStarted(Job &job);
+		void solutionFound(Job &job, QJsonArray const &colles, QJsonArray const &objectiveComputations, QJsonObject const &statistics);
+		void computationFinished(Job &job, bool success);
+
+		static QHttpServerResponse getJsonResponse(QJsonObject const &json, QHttpServerResponder::StatusCode status = QHttpServerResponder::StatusCode::Ok);
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+
+// The states shared by the test cases, as they would be sent by the user interface
+
+/** A state large enough for the model building to take a while with the default size, and smaller with fewer trios and weeks */
+inline QJsonObject getLargeJsonState(int nbTrios = 24, int nbWeeks = 30)
+{
+	QJsonArray jsonTimeslots;
+	for (int day = 0; day < 5; ++day) {
+		for (int hour = 8; hour < 19; ++hour) {
+			jsonTimeslots << QJsonObject({{"day", day}, {"hour", hour}});
+		}
+	}
+
+	QJsonArray jsonSubjects;
+	QJsonArray jsonTeachers;
+	for (int idSubject = 0; idSubject < 3; ++idSubject) {
+		auto const &subjectId = QString("subject%1").arg(idSubject);
+		jsonSubjects << QJsonObject({
+			{"id", subjectId},
+			{"name", subjectId},
+			{"shortName", subjectId},
+			{"frequency", idSubject == 0 ? 1 : 2},
+		});
+
+		for (int idTeacher = 0; idTeacher < 6; ++idTeacher) {
+			auto const &teacherId = QString("teacher%1-%2").arg(idSubject).arg(idTeacher);
+			jsonTeachers << QJsonObject({
+				{"id", teacherId},
+				{"name", teacherId},
+				{"subjectId", subjectId},
+				{"availableTimeslots", jsonTimeslots},
+				{"weeklyAvailabilityFrequency", 1},
+				{"meanWeeklyVolume", QJsonValue::Null},
+			});
+		}
+	}
+
+	QJsonArray jsonTrios;
+	for (int idTrio = 0; idTrio < nbTrios; ++idTrio) {
+		jsonTrios << QJsonObject({{"id", idTrio}, {"initialGroupIds", QJsonArray({"group"})}});
+	}
+
+	QJsonArray jsonWeeks;
+	for (int idWeek = 0; idWeek < nbWeeks; ++idWeek) {
+		jsonWeeks << QJsonObject({{"id", idWeek}, {"number", idWeek + 1}});
+	}
+
+	return {
+		{"groups", QJsonArray({QJsonObject({{"id", "group"}, {"name", "group"}, {"availableTimeslots", jsonTimeslots}})})},
+		{"subjects", jsonSubjects},
+		{"teachers", jsonTeachers},
+		{"trios", jsonTrios},
+		{"weeks", jsonWeeks},
+		{"objectives", QJsonArray()},
+		{"lunchTimeRange", QJsonArray({12, 14})},
+		{"forbiddenSubjectIdsCombination", QJsonArray()},
+	};
+}
+
+/** Two trios, a weekly subject and a fortnightly one, over four weeks and three timeslots */
+inline QJsonObject getSmallJsonState()
+{
+	auto const &jsonTimeslots = QJsonArray({
+		QJsonObject({{"day", 0}, {"hour", 10}}),
+		QJsonObject({{"day", 0}, {"hour", 11}}),
+		QJsonObject({{"day", 2}, {"hour", 16}}),
+	});
+
+	return {
+		{"groups", QJsonArray({
+			QJsonObject({{"id", "A"}, {"name", "A"}, {"availableTimeslots", jsonTimeslots}, {"nextGroupId", QJsonValue::Null}}),
+		})},
+		{"subjects", QJsonArray({
+			QJsonObject({{"id", "maths"}, {"name", "Maths"}, {"shortName", "M"}, {"frequency", 1}}),
+			QJsonObject({{"id", "physics"}, {"name", "Physics"}, {"shortName", "P"}, {"frequency", 2}}),
+		})},
+		{"teachers", QJsonArray({
+			QJsonObject({{"id", "m"}, {"name", "M"}, {"subjectId", "maths"}, {"availableTimeslots", jsonTimeslots}, {"weeklyAvailabilityFrequency", 1}, {"meanWeeklyVolume", QJsonValue::Null}}),
+			QJsonObject({{"id", "p"}, {"name", "P"}, {"subjectId", "physics"}, {"availableTimeslots", jsonTimeslots}, {"weeklyAvailabilityFrequency", 1}, {"meanWeeklyVolume", QJsonValue::Null}}),
+		})},
+		{"trios", QJsonArray({
+			QJsonObject({{"id", 0}, {"initialGroupIds", QJsonArray({"A"})}}),
+			QJsonObject({{"id", 1}, {"initialGroupIds", QJsonArray({"A"})}}),
+		})},
+		{"weeks", QJsonArray({
+			QJsonObject({{"id", 0}, {"number", 1}}),
+			QJsonObject({{"id", 1}, {"number", 2}}),
+			QJsonObject({{"id", 2}, {"number", 3}}),
+			QJsonObject({{"id", 3}, {"number", 4}}),
+		})},
+		{"objectives", QJsonArray()},
+		{"lunchTimeRange", QJsonArray({12, 14})},
+		{"forbiddenSubjectIdsCombination", QJsonArray()},
+	};
+}
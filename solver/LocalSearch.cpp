@@ -0,0 +1,292 @@
+#include "LocalSearch.h"
+
+#include <QThread>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include "Objective/Objective.h"
+#include "SolverParameters.h"
+#include "State.h"
+
+using std::vector;
+
+namespace {
+	/** Number of moves between two exchanges of the best colloscope between the threads */
+	constexpr int nbMovesBetweenExchanges = 20000;
+
+	/** Number of random moves from the initial colloscope whose cost increases give the initial temperature */
+	constexpr int nbSampledMoves = 1000;
+
+	constexpr double coolingRate = 0.9999;
+}
+
+/**
+ * As in the model, in lexicographic mode, each objective is multiplied by a factor greater than the maximal value of the less important ones,
+ * and the violations by a factor greater than the maximal value of all the objectives, whatever the mode.
+ */
+LocalSearch::LocalSearch(State const &state, vector<std::unordered_map<Subject, Week>> const &subjectsCombinations):
+	state(&state), subjectsCombinations(subjectsCombinations), initialTemperature(1), minTemperature(1), bestCost(0), isBestFeasible(false)
+{
+	auto const &objectives = state.getObjectives();
+	bool const isWeightedSum = state.getSolverParameters().getObjectiveMode() == ObjectiveMode::WeightedSum;
+	ColloscopeEvaluator const emptyEvaluator(state, {});
+
+	double factor = 1;
+	double maxCost = 0;
+	objectiveFactors.resize(objectives.size());
+	for (int idObjective = objectives.size() - 1; idObjective >= 0; --idObjective) {
+		double const maxValue = emptyEvaluator.getObjectiveMaxValue(objectives[idObjective]).value_or(0);
+		objectiveFactors[idObjective] = isWeightedSum ? state.getObjectiveWeight(objectives[idObjective]) : factor;
+		maxCost += objectiveFactors[idObjective] * maxValue;
+		factor *= maxValue + 1;
+	}
+
+	violationFactor = maxCost + 1;
+}
+
+double LocalSearch::getCost(ColloscopeEvaluator const &evaluator) const
+{
+	double cost = violationFactor * evaluator.getViolations().getTotal();
+	auto const &objectives = state->getObjectives();
+	for (std::size_t idObjective = 0; idObjective < objectives.size(); ++idObjective) {
+		cost += objectiveFactors[idObjective] * evaluator.getObjectiveValue(objectives[idObjective]).value_or(0);
+	}
+
+	return cost;
+}
+
+/** The cost of a colloscope where every objective reaches its lower bound */
+double LocalSearch::getLowerBound() const
+{
+	double lowerBound = 0;
+	auto const &objectives = state->getObjectives();
+	for (std::size_t idObjective = 0; idObjective < objectives.size(); ++idObjective) {
+		lowerBound += objectiveFactors[idObjective] * objectives[idObjective]->getLowerBound(state);
+	}
+
+	return lowerBound;
+}
+
+void LocalSearch::run(vector<Colle> const &initialColles, std::atomic<bool> const &shouldBeStopped, SolutionImprovedCallback const &solutionImproved)
+{
+	ColloscopeEvaluator initialEvaluator(*state, initialColles, subjectsCombinations);
+	bestColles = initialColles;
+	bestCost = getCost(initialEvaluator);
+	isBestFeasible = initialEvaluator.getViolations().getTotal() == 0;
+	if (isBestFeasible) {
+		solutionImproved(initialEvaluator, bestCost);
+	}
+
+	// Without any trio, teacher or week, there is no colle to add
+	if (state->getTrios().empty() || state->getTeachers().empty() || state->getWeeks().empty()) {
+		return;
+	}
+
+	setTemperatures(initialColles);
+
+	vector<int> seeds(std::max(1, QThread::idealThreadCount()));
+	std::iota(seeds.begin(), seeds.end(), 0);
+	QtConcurrent::blockingMap(seeds, [&](int seed) {
+		runThread(seed, shouldBeStopped, solutionImproved);
+	});
+}
+
+void LocalSearch::runThread(int seed, std::atomic<bool> const &shouldBeStopped, SolutionImprovedCallback const &solutionImproved)
+{
+	std::mt19937 randomGenerator(seed);
+	std::uniform_real_distribution<double> acceptanceDistribution(0, 1);
+
+	std::unique_lock lock(bestMutex);
+	ColloscopeEvaluator evaluator(*state, bestColles, subjectsCombinations);
+	lock.unlock();
+
+	double cost = getCost(evaluator);
+	double temperature = initialTemperature;
+	vector<UndoneMove> undoneMoves;
+
+	while (!shouldBeStopped) {
+		for (int idMove = 0; idMove < nbMovesBetweenExchanges && !shouldBeStopped; ++idMove) {
+			undoneMoves.clear();
+			if (!moveRandomly(evaluator, randomGenerator, undoneMoves)) {
+				continue;
+			}
+
+			// A worse colloscope is accepted with a probability decreasing with the temperature
+			double const newCost = getCost(evaluator);
+			if (newCost <= cost || acceptanceDistribution(randomGenerator) < std::exp((cost - newCost) / temperature)) {
+				cost = newCost;
+			}
+			else {
+				undo(evaluator, undoneMoves);
+			}
+
+			temperature = std::max(temperature * coolingRate, minTemperature);
+		}
+
+		// The best colloscope is shared, and the threads which have fallen behind start again from it
+		lock.lock();
+		bool const isFeasible = evaluator.getViolations().getTotal() == 0;
+		if (cost < bestCost && (isFeasible || !isBestFeasible)) {
+			bestColles = evaluator.getColles();
+			bestCost = cost;
+			isBestFeasible = isFeasible;
+			if (isFeasible) {
+				solutionImproved(evaluator, cost);
+			}
+		}
+		else if (cost > bestCost) {
+			evaluator = ColloscopeEvaluator(*state, bestColles, subjectsCombinations);
+			cost = bestCost;
+			temperature = initialTemperature;
+		}
+		lock.unlock();
+	}
+}
+
+/**
+ * A worsening move of the median cost increase is accepted half of the time at first,
+ * and the temperature then decreases until even the smallest cost increase is almost always rejected.
+ */
+void LocalSearch::setTemperatures(vector<Colle> const &colles)
+{
+	// The smallest cost increase is the one of the least important objective, or of a violation
+	double smallestCostIncrease = violationFactor;
+	for (double factor: objectiveFactors | std::views::filter([](double factor) { return factor > 0; })) {
+		smallestCostIncrease = std::min(smallestCostIncrease, factor);
+	}
+	minTemperature = smallestCostIncrease / 10;
+
+	std::mt19937 randomGenerator(0);
+	ColloscopeEvaluator evaluator(*state, colles, subjectsCombinations);
+	double const cost = getCost(evaluator);
+	vector<double> costIncreases;
+	vector<UndoneMove> undoneMoves;
+	for (int idMove = 0; idMove < nbSampledMoves; ++idMove) {
+		undoneMoves.clear();
+		if (!moveRandomly(evaluator, randomGenerator, undoneMoves)) {
+			continue;
+		}
+
+		double const newCost = getCost(evaluator);
+		if (newCost > cost) {
+			costIncreases.push_back(newCost - cost);
+		}
+		undo(evaluator, undoneMoves);
+	}
+
+	initialTemperature = minTemperature;
+	if (!costIncreases.empty()) {
+		auto const median = costIncreases.begin() + costIncreases.size() / 2;
+		std::ranges::nth_element(costIncreases, median);
+		initialTemperature = std::max(minTemperature, *median / std::numbers::ln2);
+	}
+}
+
+/**
+ * Apply one of the moves, and fill the moves which undo it:
+ * another timeslot in the same week, another teacher of the same subject, the trios of two colles of the same subject in the same week swapped,
+ * the same colle in another week, a new colle, or one colle less, so that the number of colles is not the one of the initial colloscope forever.
+ */
+bool LocalSearch::moveRandomly(ColloscopeEvaluator &evaluator, std::mt19937 &randomGenerator, vector<UndoneMove> &undoneMoves) const
+{
+	auto const &getRandomIndex = [&](auto const &elements) {
+		return std::uniform_int_distribution<int>(0, elements.size() - 1)(randomGenerator);
+	};
+
+	auto const &colles = evaluator.getColles();
+	auto const &add = [&]() {
+		auto const &trio = state->getTrios()[getRandomIndex(state->getTrios())];
+		auto const &teacher = state->getTeachers()[getRandomIndex(state->getTeachers())];
+		auto const &week = state->getWeeks()[getRandomIndex(state->getWeeks())];
+		auto const &timeslots = state->getAvailableTimeslots(teacher, trio, week);
+		if (timeslots.empty()) {
+			return false;
+		}
+
+		undoneMoves.emplace_back(static_cast<int>(colles.size()), std::nullopt);
+		evaluator.addColle(Colle(teacher, timeslots[getRandomIndex(timeslots)], trio, week));
+		return true;
+	};
+
+	if (colles.empty()) {
+		return add();
+	}
+
+	int const idColle = getRandomIndex(colles);
+	auto const colle = colles[idColle];
+	auto const &move = [&](int idMovedColle, Colle const &newColle) {
+		undoneMoves.emplace_back(idMovedColle, evaluator.getColles()[idMovedColle]);
+		evaluator.moveColle(idMovedColle, newColle);
+	};
+
+	switch (std::uniform_int_distribution<int>(0, 11)(randomGenerator)) {
+		case 0: case 1: case 2: case 3: {
+			auto const &timeslots = state->getAvailableTimeslots(colle.getTeacher(), colle.getTrio(), colle.getWeek());
+			if (timeslots.empty()) {
+				return false;
+			}
+
+			move(idColle, Colle(colle.getTeacher(), timeslots[getRandomIndex(timeslots)], colle.getTrio(), colle.getWeek()));
+			return true;
+		}
+
+		case 4: case 5: case 6: {
+			auto const &teachers = state->getTeachersOfSubject(colle.getSubject());
+			Teacher const &teacher = teachers[getRandomIndex(teachers)];
+			auto const &timeslots = state->getAvailableTimeslots(teacher, colle.getTrio(), colle.getWeek());
+			if (timeslots.empty()) {
+				return false;
+			}
+
+			move(idColle, Colle(teacher, timeslots[getRandomIndex(timeslots)], colle.getTrio(), colle.getWeek()));
+			return true;
+		}
+
+		case 7: case 8: {
+			int const idOtherColle = getRandomIndex(colles);
+			auto const otherColle = colles[idOtherColle];
+			if (idOtherColle == idColle || &otherColle.getWeek() != &colle.getWeek() || !(otherColle.getSubject() == colle.getSubject())) {
+				return false;
+			}
+
+			move(idColle, Colle(colle.getTeacher(), colle.getTimeslot(), otherColle.getTrio(), colle.getWeek()));
+			move(idOtherColle, Colle(otherColle.getTeacher(), otherColle.getTimeslot(), colle.getTrio(), otherColle.getWeek()));
+			return true;
+		}
+
+		case 9: {
+			auto const &weeks = state->getWeeks();
+			move(idColle, Colle(colle.getTeacher(), colle.getTimeslot(), colle.getTrio(), weeks[getRandomIndex(weeks)]));
+			return true;
+		}
+
+		case 10:
+			return add();
+
+		default:
+			// The last colle takes the place of the removed one, and the removed one comes back at the end
+			undoneMoves.emplace_back(static_cast<int>(colles.size()) - 1, colle);
+			evaluator.removeColle(idColle);
+			return true;
+	}
+}
+
+/** In reverse order, each move having been applied to the colles left by the previous ones */
+void LocalSearch::undo(ColloscopeEvaluator &evaluator, vector<UndoneMove> const &undoneMoves)
+{
+	for (auto const &[idColle, colle]: undoneMoves | std::views::reverse) {
+		if (!colle.has_value()) {
+			evaluator.removeColle(idColle);
+		}
+		else if (idColle == static_cast<int>(evaluator.getColles().size())) {
+			evaluator.addColle(colle.value());
+		}
+		else {
+			evaluator.moveColle(idColle, colle.value());
+		}
+	}
+}
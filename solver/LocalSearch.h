@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Colle.h"
+#include "ColloscopeEvaluator.h"
+#include "Subject.h"
+#include "Week.h"
+
+class State;
+
+/**
+ * Improve a colloscope by simulated annealing over moves, insertions and removals of single colles, without building any model.
+ * Each thread runs its own annealing, and the threads regularly restart from the best colloscope found by any of them.
+ */
+class LocalSearch
+{
+	public:
+		/** Called from any thread, one at a time, with each colloscope which respects all the constraints and improves the cost */
+		using SolutionImprovedCallback = std::function<void(ColloscopeEvaluator const &evaluator, double cost)>;
+
+		/** The subjects combinations are the ones allowed by the model, so that the trios keep a regular number of subjects each week */
+		LocalSearch(State const &state, std::vector<std::unordered_map<Subject, Week>> const &subjectsCombinations);
+		LocalSearch(State const &&state, std::vector<std::unordered_map<Subject, Week>> const &subjectsCombinations) = delete;
+
+		void run(std::vector<Colle> const &initialColles, std::atomic<bool> const &shouldBeStopped, SolutionImprovedCallback const &solutionImproved);
+		double getCost(ColloscopeEvaluator const &evaluator) const;
+		double getLowerBound() const;
+
+	protected:
+		/** The colle to put back at the index, or to remove from it when there is none */
+		using UndoneMove = std::pair<int, std::optional<Colle>>;
+
+		State const *state;
+		std::vector<std::unordered_map<Subject, Week>> subjectsCombinations;
+
+		/** The violations always outweigh the objectives, which are weighted according to the objective mode */
+		double violationFactor;
+		std::vector<double> objectiveFactors;
+
+		/** Scaled to the cost increases of the moves, which depend on the factors */
+		double initialTemperature;
+		double minTemperature;
+
+		std::mutex bestMutex;
+		std::vector<Colle> bestColles;
+		double bestCost;
+		bool isBestFeasible;
+
+		void setTemperatures(std::vector<Colle> const &colles);
+		void runThread(int seed, std::atomic<bool> const &shouldBeStopped, SolutionImprovedCallback const &solutionImproved);
+		bool moveRandomly(ColloscopeEvaluator &evaluator, std::mt19937 &randomGenerator, std::vector<UndoneMove> &undoneMoves) const;
+		static void undo(ColloscopeEvaluator &evaluator, std::vector<UndoneMove> const &undoneMoves);
+};
@@ -4,6 +4,7 @@
 #include <QString>
 #include <ranges>
 #include "ObjectiveComputation.h"
+#include "../misc.h"
 #include "../State.h"
 #include "../Teacher.h"
 #include "../Trio.h"
@@ -22,7 +23,8 @@ using std::vector;
 ObjectiveComputation EvenDistributionBetweenTeachersObjective::compute(
 	State const *state,
 	unordered_map<Trio, unordered_map<Teacher, unordered_map<Timeslot, unordered_map<Week, BoolVar>>>> const &isTrioWithTeacherAtTimeslotInWeek,
-	CpModelBuilder &modelBuilder
+	CpModelBuilder &modelBuilder,
+	std::atomic<bool> const &shouldComputationBeStopped
 ) const
 {
 	LinearExpr expression;
@@ -38,6 +40,8 @@ ObjectiveComputation EvenDistributionBetweenTeachersObjective::compute(
 		intervalSizeByTeacher[teacher] = modelBuilder.NewIntVar({0, nbWeeks});
 
 		for (auto const &trio: state->getTrios()) {
+			throwIfComputationStopped(shouldComputationBeStopped);
+
 			vector<IntVar> nbWeeksSinceLastColleWithTeacher;
 			for (int idWeek = 0; idWeek < nbWeeks; ++idWeek) {
 				auto const &week = state->getWeeks().at(idWeek);
@@ -79,7 +83,7 @@ ObjectiveComputation EvenDistributionBetweenTeachersObjective::compute(
 	int factor = maxValue + 1;
 	for (auto const &subject: state->getSubjects()) {
 		vector<IntVar> intervalSizesOfSubject;
-		for (auto const &teacher: state->getTeachersOfSubject(subject)) {
+		for (Teacher const &teacher: state->getTeachersOfSubject(subject)) {
 			intervalSizesOfSubject.push_back(intervalSizeByTeacher[teacher]);
 		}
 
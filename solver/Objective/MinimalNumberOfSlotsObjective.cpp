@@ -2,8 +2,11 @@
 
 #include <ortools/sat/cp_model.h>
 #include <QString>
+#include <algorithm>
 #include "ObjectiveComputation.h"
+#include "../misc.h"
 #include "../State.h"
+#include "../Subject.h"
 #include "../Teacher.h"
 #include "../Trio.h"
 #include "../Week.h"
@@ -17,19 +20,22 @@ using std::vector;
 ObjectiveComputation MinimalNumberOfSlotsObjective::compute(
 	State const *state,
 	unordered_map<Trio, unordered_map<Teacher, unordered_map<Timeslot, unordered_map<Week, BoolVar>>>> const &isTrioWithTeacherAtTimeslotInWeek,
-	CpModelBuilder &modelBuilder
+	CpModelBuilder &modelBuilder,
+	std::atomic<bool> const &shouldComputationBeStopped
 ) const
 {
 	LinearExpr expression;
 	int maxValue = 0;
 
 	for (auto const &teacher: state->getTeachers()) {
+		throwIfComputationStopped(shouldComputationBeStopped);
+
 		for (auto const &timeslot: teacher.getAvailableTimeslots()) {
 			LinearExpr nbCollesInSlot;
 
 			for (auto const &week: state->getWeeks()) {
 				for (auto const &trio: state->getTrios()) {
-					if (trio.getAvailableTimeslotsInWeek(week).contains(timeslot)) {
+					if (state->getAvailableTimeslots(trio, week).contains(timeslot)) {
 						nbCollesInSlot += isTrioWithTeacherAtTimeslotInWeek.at(trio).at(teacher).at(timeslot).at(week);
 					}
 				}
@@ -47,6 +53,35 @@ ObjectiveComputation MinimalNumberOfSlotsObjective::compute(
 	return ObjectiveComputation(this, expression, maxValue);
 }
 
+/**
+ * A slot hosts at most one colle each week.
+ * Each subject needs at least as many slots as its colles during its busiest week, where the trios have their colles over `frequency` weeks,
+ * and each teacher at least as many as its total volume spread over all weeks.
+ */
+int MinimalNumberOfSlotsObjective::getLowerBound(State const *state) const
+{
+	int const nbWeeks = state->getWeeks().size();
+	if (nbWeeks == 0) {
+		return 0;
+	}
+
+	int lowerBound = 0;
+	for (auto const &subject: state->getSubjects()) {
+		int const nbSlotsForTrios = subject.getFrequency() <= nbWeeks ? divideCeil(state->getTrios().size(), subject.getFrequency()) : 0;
+
+		int nbSlotsForTeachers = 0;
+		for (Teacher const &teacher: state->getTeachersOfSubject(subject)) {
+			if (teacher.hasMeanWeeklyVolume()) {
+				nbSlotsForTeachers += divideCeil(std::max(0, teacher.getTotalVolume(nbWeeks).value), nbWeeks);
+			}
+		}
+
+		lowerBound += std::max(nbSlotsForTrios, nbSlotsForTeachers);
+	}
+
+	return lowerBound;
+}
+
 QString MinimalNumberOfSlotsObjective::getName() const
 {
 	return "Minimal number of slots";
@@ -3,6 +3,7 @@
 #include <ortools/sat/cp_model.h>
 #include <QString>
 #include "ObjectiveComputation.h"
+#include "../misc.h"
 #include "../State.h"
 
 using operations_research::sat::BoolVar;
@@ -14,31 +15,61 @@ using std::vector;
 ObjectiveComputation NoConsecutiveCollesObjective::compute(
 	State const *state,
 	unordered_map<Trio, unordered_map<Teacher, unordered_map<Timeslot, unordered_map<Week, BoolVar>>>> const &isTrioWithTeacherAtTimeslotInWeek,
-	CpModelBuilder &modelBuilder
+	CpModelBuilder &modelBuilder,
+	std::atomic<bool> const &shouldComputationBeStopped
 ) const
 {
 	LinearExpr expression;
 	int maxValue = 0;
 
+	// A trio has at most one colle at a time, so two consecutive timeslots are used when the trio is busy in both,
+	// which only needs a single variable for each timeslot instead of a sum for each pair of timeslots.
+	unordered_map<Timeslot, vector<BoolVar>> collesOfTrioByTimeslot;
+	unordered_map<Timeslot, BoolVar> isTrioBusyByTimeslot;
+	auto const &isTrioBusy = [&](Timeslot const &timeslot) {
+		auto const &[isTrioBusyInTimeslot, isNew] = isTrioBusyByTimeslot.try_emplace(timeslot);
+		if (isNew) {
+			auto const &collesOfTrioInTimeslot = collesOfTrioByTimeslot.at(timeslot);
+			if (collesOfTrioInTimeslot.size() == 1) {
+				isTrioBusyInTimeslot->second = collesOfTrioInTimeslot.front();
+			}
+			else {
+				isTrioBusyInTimeslot->second = modelBuilder.NewBoolVar();
+				modelBuilder.AddEquality(LinearExpr::Sum(collesOfTrioInTimeslot), isTrioBusyInTimeslot->second);
+			}
+		}
+
+		return isTrioBusyInTimeslot->second;
+	};
+
 	for (auto const &week: state->getWeeks()) {
 		for (auto const &trio: state->getTrios()) {
-			unordered_map<Timeslot, LinearExpr> nbCollesOfTrioByTimeslot;
+			throwIfComputationStopped(shouldComputationBeStopped);
+
+			// The containers are cleared instead of recreated, so that their buckets are reused
+			for (auto &[timeslot, collesOfTrioInTimeslot]: collesOfTrioByTimeslot) {
+				collesOfTrioInTimeslot.clear();
+			}
+			isTrioBusyByTimeslot.clear();
+
 			for (auto const &teacher: state->getTeachers()) {
 				for (auto const &timeslot: state->getAvailableTimeslots(teacher, trio, week)) {
-					nbCollesOfTrioByTimeslot[timeslot] += isTrioWithTeacherAtTimeslotInWeek.at(trio).at(teacher).at(timeslot).at(week);
+					collesOfTrioByTimeslot[timeslot].push_back(isTrioWithTeacherAtTimeslotInWeek.at(trio).at(teacher).at(timeslot).at(week));
 				}
 			}
 
-			for (auto const &[timeslot, nbCollesOfTrioInTimeslot]: nbCollesOfTrioByTimeslot) {
-				auto nextTimeslot = timeslot.next();
-				if (!nbCollesOfTrioByTimeslot.contains(nextTimeslot)) {
+			for (auto const &[timeslot, collesOfTrioInTimeslot]: collesOfTrioByTimeslot) {
+				auto const &nextTimeslot = timeslot.next();
+				auto const &collesOfTrioInNextTimeslot = collesOfTrioByTimeslot.find(nextTimeslot);
+				if (collesOfTrioInTimeslot.empty() || collesOfTrioInNextTimeslot == collesOfTrioByTimeslot.end() || collesOfTrioInNextTimeslot->second.empty()) {
 					continue;
 				}
 
-				auto nbCollesOfTrioInNextTimeslot = nbCollesOfTrioByTimeslot.at(nextTimeslot);
+				auto const &isTrioBusyInTimeslot = isTrioBusy(timeslot);
+				auto const &isTrioBusyInNextTimeslot = isTrioBusy(nextTimeslot);
 				auto areConsecutiveSlotsUsed = modelBuilder.NewBoolVar();
-				modelBuilder.AddGreaterOrEqual(nbCollesOfTrioInTimeslot + nbCollesOfTrioInNextTimeslot, 2).OnlyEnforceIf(areConsecutiveSlotsUsed);
-				modelBuilder.AddLessThan(nbCollesOfTrioInTimeslot + nbCollesOfTrioInNextTimeslot, 2).OnlyEnforceIf(areConsecutiveSlotsUsed.Not());
+				modelBuilder.AddBoolAnd({isTrioBusyInTimeslot, isTrioBusyInNextTimeslot}).OnlyEnforceIf(areConsecutiveSlotsUsed);
+				modelBuilder.AddBoolOr({isTrioBusyInTimeslot.Not(), isTrioBusyInNextTimeslot.Not()}).OnlyEnforceIf(areConsecutiveSlotsUsed.Not());
 
 				expression += areConsecutiveSlotsUsed;
 				maxValue++;
@@ -9,7 +9,8 @@ class NoConsecutiveCollesObjective : public Objective
 		ObjectiveComputation compute(
 			State const *state,
 			std::unordered_map<Trio, std::unordered_map<Teacher, std::unordered_map<Timeslot, std::unordered_map<Week, operations_research::sat::BoolVar>>>> const &isTrioWithTeacherAtTimeslotInWeek,
-			operations_research::sat::CpModelBuilder &modelBuilder
+			operations_research::sat::CpModelBuilder &modelBuilder,
+			std::atomic<bool> const &shouldComputationBeStopped
 		) const override;
 		QString getName() const override;
 };
@@ -5,4 +5,10 @@ Objective::Objective()
 
 }
 
+/** A value that the expression of the objective cannot go under, derived from the state only, and thus added to the model before the search */
+int Objective::getLowerBound(State const *) const
+{
+	return 0;
+}
+
 Objective::~Objective() = default;
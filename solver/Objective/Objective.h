@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <vector>
 #include <unordered_map>
 #include <utility>
@@ -25,8 +26,10 @@ class Objective
 		virtual ObjectiveComputation compute(
 			State const *state,
 			std::unordered_map<Trio, std::unordered_map<Teacher, std::unordered_map<Timeslot, std::unordered_map<Week, operations_research::sat::BoolVar>>>> const &isTrioWithTeacherAtTimeslotInWeek,
-			operations_research::sat::CpModelBuilder &modelBuilder
+			operations_research::sat::CpModelBuilder &modelBuilder,
+			std::atomic<bool> const &shouldComputationBeStopped
 		) const = 0;
+		virtual int getLowerBound(State const *state) const;
 		virtual QString getName() const = 0;
 		virtual ~Objective() = 0;
 };
@@ -25,6 +25,16 @@ int ObjectiveComputation::getMaxValue() const
 	return maxValue;
 }
 
+int ObjectiveComputation::getLowerBound() const
+{
+	return lowerBound;
+}
+
+void ObjectiveComputation::setLowerBound(int newLowerBound)
+{
+	lowerBound = newLowerBound;
+}
+
 int ObjectiveComputation::getValue() const
 {
 	if (!value.has_value()) {
@@ -34,11 +44,18 @@ int ObjectiveComputation::getValue() const
 	return value.value();
 }
 
+/** For a value computed without the model, e.g. by a `ColloscopeEvaluator` */
+void ObjectiveComputation::setValue(int newValue)
+{
+	value = newValue;
+}
+
 QJsonObject ObjectiveComputation::toJsonObject() const
 {
 	return {
 		{"objectiveName", objective->getName()},
 		{"value", getValue()},
+		{"lowerBound", lowerBound},
 	};
 }
 
@@ -46,3 +63,26 @@ void ObjectiveComputation::evaluate(const operations_research::sat::CpSolverResp
 {
 	value = operations_research::sat::SolutionIntegerValue(response, expression);
 }
+
+bool ObjectiveComputation::isLazy() const
+{
+	return static_cast<bool>(lazyTermsGenerator);
+}
+
+void ObjectiveComputation::setLazyTermsGenerator(LazyTermsGenerator const &generator)
+{
+	lazyTermsGenerator = generator;
+}
+
+int ObjectiveComputation::addLazyTerms(
+	std::vector<Colle> const &colles,
+	std::unordered_map<Trio, std::unordered_map<Teacher, std::unordered_map<Timeslot, std::unordered_map<Week, operations_research::sat::BoolVar>>>> const &isTrioWithTeacherAtTimeslotInWeek,
+	operations_research::sat::CpModelBuilder &modelBuilder
+)
+{
+	if (!isLazy()) {
+		return 0;
+	}
+
+	return lazyTermsGenerator(colles, isTrioWithTeacherAtTimeslotInWeek, modelBuilder, expression);
+}
@@ -1,11 +1,30 @@
 #pragma once
 
 #include <ortools/sat/cp_model.h>
+#include <functional>
 #include <memory>
 #include <optional>
+#include <unordered_map>
+#include <vector>
 
 class QJsonObject;
+class Colle;
 class Objective;
+class Teacher;
+class Timeslot;
+class Trio;
+class Week;
+
+/**
+ * Add to the model, and to the given expression, the terms of the objective which the given colles violate and which are not part of the model yet.
+ * Returns the number of added terms.
+ */
+using LazyTermsGenerator = std::function<int(
+	std::vector<Colle> const &colles,
+	std::unordered_map<Trio, std::unordered_map<Teacher, std::unordered_map<Timeslot, std::unordered_map<Week, operations_research::sat::BoolVar>>>> const &isTrioWithTeacherAtTimeslotInWeek,
+	operations_research::sat::CpModelBuilder &modelBuilder,
+	operations_research::sat::LinearExpr &expression
+)>;
 
 class ObjectiveComputation {
 	public:
@@ -13,11 +32,22 @@ class ObjectiveComputation {
 		Objective const* getObjective() const;
 		operations_research::sat::LinearExpr const &getExpression() const;
 		int getMaxValue() const;
+		int getLowerBound() const;
+		void setLowerBound(int newLowerBound);
 		int getValue() const;
+		void setValue(int newValue);
 		QJsonObject toJsonObject() const;
 
 		void evaluate(operations_research::sat::CpSolverResponse const &response);
 
+		bool isLazy() const;
+		void setLazyTermsGenerator(LazyTermsGenerator const &generator);
+		int addLazyTerms(
+			std::vector<Colle> const &colles,
+			std::unordered_map<Trio, std::unordered_map<Teacher, std::unordered_map<Timeslot, std::unordered_map<Week, operations_research::sat::BoolVar>>>> const &isTrioWithTeacherAtTimeslotInWeek,
+			operations_research::sat::CpModelBuilder &modelBuilder
+		);
+
 	protected:
 		Objective const* objective;
 
@@ -25,6 +55,10 @@ class ObjectiveComputation {
 		operations_research::sat::LinearExpr expression;
 
 		int maxValue = 0;
+		int lowerBound = 0;
 		std::optional<int> value;
+
+		/** Only set for the objectives whose terms are added to the model once a solution violates them */
+		LazyTermsGenerator lazyTermsGenerator;
 };
 
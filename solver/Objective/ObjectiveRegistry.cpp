@@ -0,0 +1,48 @@
+#include "ObjectiveRegistry.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include "EvenDistributionBetweenTeachersObjective.h"
+#include "MinimalNumberOfSlotsObjective.h"
+#include "NoConsecutiveCollesObjective.h"
+#include "Objective.h"
+#include "OnlyOneCollePerDayObjective.h"
+#include "SameSlotOnlyOnceInCycleObjective.h"
+
+void ObjectiveRegistry::add(Factory const &factory)
+{
+	names.push_back(factory()->getName());
+	factories.push_back(factory);
+}
+
+bool ObjectiveRegistry::contains(QString const &name) const
+{
+	return std::ranges::find(names, name) != names.end();
+}
+
+std::unique_ptr<Objective> ObjectiveRegistry::create(QString const &name) const
+{
+	auto const &position = std::ranges::find(names, name);
+	if (position == names.end()) {
+		throw std::invalid_argument("Unknown objective: " + name.toStdString());
+	}
+
+	return factories[position - names.begin()]();
+}
+
+std::vector<QString> const &ObjectiveRegistry::getNames() const
+{
+	return names;
+}
+
+ObjectiveRegistry ObjectiveRegistry::getDefault()
+{
+	ObjectiveRegistry registry;
+	registry.add<EvenDistributionBetweenTeachersObjective>();
+	registry.add<MinimalNumberOfSlotsObjective>();
+	registry.add<NoConsecutiveCollesObjective>();
+	registry.add<OnlyOneCollePerDayObjective>();
+	registry.add<SameSlotOnlyOnceInCycleObjective>();
+
+	return registry;
+}
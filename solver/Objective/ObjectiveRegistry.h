@@ -0,0 +1,33 @@
+#pragma once
+
+#include <QString>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class Objective;
+
+/** The objectives that can be enabled from the JSON state, created by name */
+class ObjectiveRegistry
+{
+	public:
+		using Factory = std::function<std::unique_ptr<Objective>()>;
+
+		template <typename ConcreteObjective>
+		void add()
+		{
+			add([]() { return std::make_unique<ConcreteObjective>(); });
+		}
+		void add(Factory const &factory);
+
+		bool contains(QString const &name) const;
+		std::unique_ptr<Objective> create(QString const &name) const;
+		std::vector<QString> const &getNames() const;
+
+		static ObjectiveRegistry getDefault();
+
+	protected:
+		/** In the order of registration, which is the default order of importance */
+		std::vector<QString> names;
+		std::vector<Factory> factories;
+};
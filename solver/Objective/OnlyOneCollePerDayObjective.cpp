@@ -2,8 +2,14 @@
 
 #include <ortools/sat/cp_model.h>
 #include <QString>
+#include <algorithm>
+#include <ranges>
+#include <set>
 #include "ObjectiveComputation.h"
+#include "../misc.h"
 #include "../State.h"
+#include "../Subject.h"
+#include "../Teacher.h"
 
 using operations_research::sat::BoolVar;
 using operations_research::sat::CpModelBuilder;
@@ -14,7 +20,8 @@ using std::vector;
 ObjectiveComputation OnlyOneCollePerDayObjective::compute(
 	State const *state,
 	unordered_map<Trio, unordered_map<Teacher, unordered_map<Timeslot, unordered_map<Week, BoolVar>>>> const &isTrioWithTeacherAtTimeslotInWeek,
-	CpModelBuilder &modelBuilder
+	CpModelBuilder &modelBuilder,
+	std::atomic<bool> const &shouldComputationBeStopped
 ) const
 {
 	LinearExpr expression;
@@ -22,6 +29,8 @@ ObjectiveComputation OnlyOneCollePerDayObjective::compute(
 
 	for (auto const &week: state->getWeeks()) {
 		for (auto const &trio: state->getTrios()) {
+			throwIfComputationStopped(shouldComputationBeStopped);
+
 			for (auto const &day: Timeslot::days) {
 				LinearExpr nbCollesOfTrioInDay;
 				std::set<Timeslot> timeslotsOfCollesOfTrioInDay;
@@ -63,6 +72,37 @@ ObjectiveComputation OnlyOneCollePerDayObjective::compute(
 	return ObjectiveComputation(this, expression, maxValue);
 }
 
+/**
+ * Each week, a trio has one colle of each subject with a frequency of 1,
+ * so at least the number of such colles minus the number of days where they can take place are redundant.
+ */
+int OnlyOneCollePerDayObjective::getLowerBound(State const *state) const
+{
+	auto const &weeklySubjects = state->getSubjects() | std::views::filter([](auto const &subject) { return subject.getFrequency() == 1; });
+	int const nbWeeklyColles = std::ranges::distance(weeklySubjects);
+	if (nbWeeklyColles < 2) {
+		return 0;
+	}
+
+	int lowerBound = 0;
+	for (auto const &week: state->getWeeks()) {
+		for (auto const &trio: state->getTrios()) {
+			std::set<Day> availableDays;
+			for (auto const &subject: weeklySubjects) {
+				for (Teacher const &teacher: state->getTeachersOfSubject(subject)) {
+					for (auto const &timeslot: state->getAvailableTimeslots(teacher, trio, week)) {
+						availableDays.insert(timeslot.getDay());
+					}
+				}
+			}
+
+			lowerBound += std::max(0, nbWeeklyColles - static_cast<int>(availableDays.size()));
+		}
+	}
+
+	return lowerBound;
+}
+
 QString OnlyOneCollePerDayObjective::getName() const
 {
 	return "Only one colle per day";
@@ -2,9 +2,14 @@
 
 #include <ortools/sat/cp_model.h>
 #include <QString>
+#include <algorithm>
+#include <memory>
 #include <ranges>
+#include <set>
 #include "ObjectiveComputation.h"
 #include "../misc.h"
+#include "../Colle.h"
+#include "../SolverParameters.h"
 #include "../State.h"
 #include "../Teacher.h"
 #include "../Trio.h"
@@ -19,7 +24,8 @@ using std::vector;
 ObjectiveComputation SameSlotOnlyOnceInCycleObjective::compute(
 	State const *state,
 	unordered_map<Trio, unordered_map<Teacher, unordered_map<Timeslot, unordered_map<Week, BoolVar>>>> const &isTrioWithTeacherAtTimeslotInWeek,
-	CpModelBuilder &modelBuilder
+	CpModelBuilder &modelBuilder,
+	std::atomic<bool> const &shouldComputationBeStopped
 ) const
 {
 	LinearExpr expression;
@@ -28,13 +34,15 @@ ObjectiveComputation SameSlotOnlyOnceInCycleObjective::compute(
 	unordered_map<Subject, LinearExpr> nbTimeslotsInSubject;
 	unordered_map<Teacher, unordered_map<Timeslot, BoolVar>> doesTeacherUseTimeslot;
 	for (auto const &subject: state->getSubjects()) {
-		for (auto const &teacher: state->getTeachersOfSubject(subject)) {
+		for (Teacher const &teacher: state->getTeachersOfSubject(subject)) {
+			throwIfComputationStopped(shouldComputationBeStopped);
+
 			for (auto const &timeslot: teacher.getAvailableTimeslots()) {
 				LinearExpr nbCollesWithTeacherInTimeslot;
 
 				for (auto const &trio: state->getTrios()) {
 					for (auto const &week: state->getWeeks()) {
-						if (trio.getAvailableTimeslotsInWeek(week).contains(timeslot)) {
+						if (state->getAvailableTimeslots(trio, week).contains(timeslot)) {
 							nbCollesWithTeacherInTimeslot += isTrioWithTeacherAtTimeslotInWeek.at(trio).at(teacher).at(timeslot).at(week);
 						}
 					}
@@ -49,6 +57,10 @@ ObjectiveComputation SameSlotOnlyOnceInCycleObjective::compute(
 		}
 	}
 
+	// In lazy mode, the terms of the intervals are only added once a solution has more than one colle in them
+	bool const isLazy = state->getSolverParameters().areSameSlotIntervalsLazy();
+	auto const shouldEnforceVars = std::make_shared<std::map<std::tuple<int, Timeslot, int>, BoolVar>>();
+
 	for (auto const &subject: state->getSubjects()) {
 		auto const intervalSizeExpr = nbTimeslotsInSubject[subject] * subject.getFrequency();
 		int const minIntervalSize = std::min(
@@ -66,33 +78,28 @@ ObjectiveComputation SameSlotOnlyOnceInCycleObjective::compute(
 				modelBuilder.AddNotEqual(intervalSizeExpr, intervalSize).OnlyEnforceIf(isIntervalOfGivenSize.Not());
 			}
 
-			for (auto const &teacher: state->getTeachersOfSubject(subject)) {
+			for (Teacher const &teacher: state->getTeachersOfSubject(subject)) {
 				for (auto const &timeslot: teacher.getAvailableTimeslots()) {
+					throwIfComputationStopped(shouldComputationBeStopped);
+
 					auto shouldEnforce = modelBuilder.NewBoolVar();
 					modelBuilder.AddBoolAnd({doesTeacherUseTimeslot[teacher][timeslot], isIntervalOfGivenSize}).OnlyEnforceIf(shouldEnforce);
 					modelBuilder.AddBoolOr({doesTeacherUseTimeslot[teacher][timeslot].Not(), isIntervalOfGivenSize.Not()}).OnlyEnforceIf(shouldEnforce.Not());
 
+					// `hasTrioExactlyOneColleWithTeacherInTimeslotInInterval` is always false, except for one value of `intervalSize`,
+					// so we only need to increment `maxValue` for the wider possible loop.
+					if (intervalSize == minIntervalSize) {
+						maxValue += state->getTrios().size() * (state->getWeeks().size() - intervalSize + 1);
+					}
+
+					if (isLazy) {
+						(*shouldEnforceVars)[{teacher.getIndex(), timeslot, intervalSize}] = shouldEnforce;
+						continue;
+					}
+
 					for (auto const &trio: state->getTrios()) {
 						for (int idStartingWeek = 0; idStartingWeek <= state->getWeeks().size() - intervalSize; ++idStartingWeek) {
-							LinearExpr nbCollesOfTrioWithTeacherInTimeslotInInterval;
-							for (auto const &week: state->getWeeks() | std::views::drop(idStartingWeek) | std::views::take(intervalSize)) {
-								if (trio.getAvailableTimeslotsInWeek(week).contains(timeslot)) {
-									nbCollesOfTrioWithTeacherInTimeslotInInterval += isTrioWithTeacherAtTimeslotInWeek.at(trio).at(teacher).at(timeslot).at(week);
-								}
-							}
-
-							auto hasTrioMoreThanOneColleWithTeacherInTimeslotInInterval = modelBuilder.NewBoolVar();
-							modelBuilder.AddGreaterThan(nbCollesOfTrioWithTeacherInTimeslotInInterval, 1).OnlyEnforceIf({shouldEnforce, hasTrioMoreThanOneColleWithTeacherInTimeslotInInterval});
-							modelBuilder.AddLessOrEqual(nbCollesOfTrioWithTeacherInTimeslotInInterval, 1).OnlyEnforceIf({shouldEnforce, hasTrioMoreThanOneColleWithTeacherInTimeslotInInterval.Not()});
-							modelBuilder.AddEquality(hasTrioMoreThanOneColleWithTeacherInTimeslotInInterval, false).OnlyEnforceIf(shouldEnforce.Not());
-
-							expression += hasTrioMoreThanOneColleWithTeacherInTimeslotInInterval;
-
-							// `hasTrioExactlyOneColleWithTeacherInTimeslotInInterval` is always false, except for one value of `intervalSize`,
-							// so we only need to increment `maxValue` for the wider possible loop.
-							if (intervalSize == minIntervalSize) {
-								maxValue++;
-							}
+							expression += addIntervalTerm(state, isTrioWithTeacherAtTimeslotInWeek, modelBuilder, shouldEnforce, teacher, timeslot, trio, idStartingWeek, intervalSize);
 						}
 					}
 				}
@@ -100,7 +107,98 @@ ObjectiveComputation SameSlotOnlyOnceInCycleObjective::compute(
 		}
 	}
 
-	return ObjectiveComputation(this, expression, maxValue);
+	ObjectiveComputation objectiveComputation(this, expression, maxValue);
+	if (isLazy) {
+		auto const addedIntervals = std::make_shared<std::set<std::tuple<int, Timeslot, int, int, int>>>();
+		objectiveComputation.setLazyTermsGenerator([state, shouldEnforceVars, addedIntervals](auto const &colles, auto const &isTrioWithTeacherAtTimeslotInWeek, auto &modelBuilder, auto &expression) {
+			return addViolatedIntervalTerms(state, *shouldEnforceVars, *addedIntervals, colles, isTrioWithTeacherAtTimeslotInWeek, modelBuilder, expression);
+		});
+	}
+
+	return objectiveComputation;
+}
+
+/**
+ * The interval of a subject is given by the number of slots it uses in the colles, as in the model,
+ * and the terms are added for each interval where a trio has more than one colle with the same teacher at the same timeslot.
+ */
+int SameSlotOnlyOnceInCycleObjective::addViolatedIntervalTerms(
+	State const *state,
+	std::map<std::tuple<int, Timeslot, int>, BoolVar> const &shouldEnforceVars,
+	std::set<std::tuple<int, Timeslot, int, int, int>> &addedIntervals,
+	vector<Colle> const &colles,
+	unordered_map<Trio, unordered_map<Teacher, unordered_map<Timeslot, unordered_map<Week, BoolVar>>>> const &isTrioWithTeacherAtTimeslotInWeek,
+	CpModelBuilder &modelBuilder,
+	LinearExpr &expression
+)
+{
+	int const nbWeeks = state->getWeeks().size();
+
+	std::map<std::tuple<int, Timeslot, int>, vector<int>> weeksOfCollesByTrioWithTeacherAtTimeslot;
+	std::set<std::pair<int, Timeslot>> usedSlots;
+	vector<int> nbUsedSlotsOfSubject(state->getSubjects().size(), 0);
+	for (auto const &colle: colles) {
+		int const idTrio = &colle.getTrio() - state->getTrios().data();
+		int const idWeek = &colle.getWeek() - state->getWeeks().data();
+		weeksOfCollesByTrioWithTeacherAtTimeslot[{colle.getTeacher().getIndex(), colle.getTimeslot(), idTrio}].push_back(idWeek);
+		if (usedSlots.emplace(colle.getTeacher().getIndex(), colle.getTimeslot()).second) {
+			++nbUsedSlotsOfSubject[colle.getSubject().getIndex()];
+		}
+	}
+
+	int nbAddedTerms = 0;
+	for (auto &[key, weeks]: weeksOfCollesByTrioWithTeacherAtTimeslot) {
+		auto const &[idTeacher, timeslot, idTrio] = key;
+		auto const &teacher = state->getTeachers()[idTeacher];
+		auto const &subject = teacher.getSubject();
+		int const intervalSize = std::min(nbUsedSlotsOfSubject[subject.getIndex()] * subject.getFrequency(), nbWeeks);
+
+		// There is no term when the interval is smaller than the minimal one
+		auto const &shouldEnforce = shouldEnforceVars.find({idTeacher, timeslot, intervalSize});
+		if (shouldEnforce == shouldEnforceVars.end()) {
+			continue;
+		}
+
+		std::ranges::sort(weeks);
+		for (std::size_t idWeek = 0; idWeek + 1 < weeks.size(); ++idWeek) {
+			for (int idStartingWeek = std::max(0, weeks[idWeek + 1] - intervalSize + 1); idStartingWeek <= std::min(weeks[idWeek], nbWeeks - intervalSize); ++idStartingWeek) {
+				if (addedIntervals.emplace(idTeacher, timeslot, idTrio, intervalSize, idStartingWeek).second) {
+					expression += addIntervalTerm(state, isTrioWithTeacherAtTimeslotInWeek, modelBuilder, shouldEnforce->second, teacher, timeslot, state->getTrios()[idTrio], idStartingWeek, intervalSize);
+					++nbAddedTerms;
+				}
+			}
+		}
+	}
+
+	return nbAddedTerms;
+}
+
+/** Whether the trio has more than one colle with the teacher at the timeslot in the interval, only when the interval has the enforced size */
+BoolVar SameSlotOnlyOnceInCycleObjective::addIntervalTerm(
+	State const *state,
+	unordered_map<Trio, unordered_map<Teacher, unordered_map<Timeslot, unordered_map<Week, BoolVar>>>> const &isTrioWithTeacherAtTimeslotInWeek,
+	CpModelBuilder &modelBuilder,
+	BoolVar const &shouldEnforce,
+	Teacher const &teacher,
+	Timeslot const &timeslot,
+	Trio const &trio,
+	int idStartingWeek,
+	int intervalSize
+)
+{
+	LinearExpr nbCollesOfTrioWithTeacherInTimeslotInInterval;
+	for (auto const &week: state->getWeeks() | std::views::drop(idStartingWeek) | std::views::take(intervalSize)) {
+		if (state->getAvailableTimeslots(trio, week).contains(timeslot)) {
+			nbCollesOfTrioWithTeacherInTimeslotInInterval += isTrioWithTeacherAtTimeslotInWeek.at(trio).at(teacher).at(timeslot).at(week);
+		}
+	}
+
+	auto hasTrioMoreThanOneColleWithTeacherInTimeslotInInterval = modelBuilder.NewBoolVar();
+	modelBuilder.AddGreaterThan(nbCollesOfTrioWithTeacherInTimeslotInInterval, 1).OnlyEnforceIf({shouldEnforce, hasTrioMoreThanOneColleWithTeacherInTimeslotInInterval});
+	modelBuilder.AddLessOrEqual(nbCollesOfTrioWithTeacherInTimeslotInInterval, 1).OnlyEnforceIf({shouldEnforce, hasTrioMoreThanOneColleWithTeacherInTimeslotInInterval.Not()});
+	modelBuilder.AddEquality(hasTrioMoreThanOneColleWithTeacherInTimeslotInInterval, false).OnlyEnforceIf(shouldEnforce.Not());
+
+	return hasTrioMoreThanOneColleWithTeacherInTimeslotInInterval;
 }
 
 QString SameSlotOnlyOnceInCycleObjective::getName() const
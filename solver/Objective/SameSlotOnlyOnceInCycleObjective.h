@@ -1,6 +1,16 @@
 #pragma once
 
+#include <map>
+#include <set>
+#include <tuple>
+#include <vector>
 #include "Objective.h"
+#include "../Timeslot.h"
+
+namespace operations_research::sat {
+	class LinearExpr;
+}
+class Colle;
 
 class SameSlotOnlyOnceInCycleObjective : public Objective
 {
@@ -9,8 +19,31 @@ class SameSlotOnlyOnceInCycleObjective : public Objective
 		ObjectiveComputation compute(
 			State const *state,
 			std::unordered_map<Trio, std::unordered_map<Teacher, std::unordered_map<Timeslot, std::unordered_map<Week, operations_research::sat::BoolVar>>>> const &isTrioWithTeacherAtTimeslotInWeek,
-			operations_research::sat::CpModelBuilder &modelBuilder
+			operations_research::sat::CpModelBuilder &modelBuilder,
+			std::atomic<bool> const &shouldComputationBeStopped
 		) const override;
 		QString getName() const override;
+
+	protected:
+		static int addViolatedIntervalTerms(
+			State const *state,
+			std::map<std::tuple<int, Timeslot, int>, operations_research::sat::BoolVar> const &shouldEnforceVars,
+			std::set<std::tuple<int, Timeslot, int, int, int>> &addedIntervals,
+			std::vector<Colle> const &colles,
+			std::unordered_map<Trio, std::unordered_map<Teacher, std::unordered_map<Timeslot, std::unordered_map<Week, operations_research::sat::BoolVar>>>> const &isTrioWithTeacherAtTimeslotInWeek,
+			operations_research::sat::CpModelBuilder &modelBuilder,
+			operations_research::sat::LinearExpr &expression
+		);
+		static operations_research::sat::BoolVar addIntervalTerm(
+			State const *state,
+			std::unordered_map<Trio, std::unordered_map<Teacher, std::unordered_map<Timeslot, std::unordered_map<Week, operations_research::sat::BoolVar>>>> const &isTrioWithTeacherAtTimeslotInWeek,
+			operations_research::sat::CpModelBuilder &modelBuilder,
+			operations_research::sat::BoolVar const &shouldEnforce,
+			Teacher const &teacher,
+			Timeslot const &timeslot,
+			Trio const &trio,
+			int idStartingWeek,
+			int intervalSize
+		);
 };
 
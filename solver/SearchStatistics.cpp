@@ -0,0 +1,61 @@
+#include "SearchStatistics.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+/** Halve the resolution of the curve when it gets too long, so that the statistics sent with each solution stay small */
+void SearchStatistics::addImprovement(double time, double value)
+{
+	improvements.emplace_back(time, value);
+	if (improvements.size() <= maxNbImprovements) {
+		return;
+	}
+
+	// The first and the last improvements are always kept
+	std::vector<std::pair<double, double>> decimatedImprovements;
+	for (std::size_t idImprovement = 0; idImprovement + 1 < improvements.size(); idImprovement += 2) {
+		decimatedImprovements.push_back(improvements[idImprovement]);
+	}
+	decimatedImprovements.push_back(improvements.back());
+	improvements = std::move(decimatedImprovements);
+}
+
+/** Relative gap between the objective value and the best bound, computed as CP-SAT does */
+double SearchStatistics::getGap() const
+{
+	return std::abs(objectiveValue - bestBound) / std::max(1.0, std::abs(objectiveValue));
+}
+
+QJsonObject SearchStatistics::toJsonObject() const
+{
+	QJsonArray jsonImprovements;
+	for (auto const &[time, value]: improvements) {
+		jsonImprovements << QJsonArray({time, value});
+	}
+
+	QJsonArray jsonMemoryUsages;
+	for (auto const &memoryUsage: memoryUsages) {
+		jsonMemoryUsages << QJsonObject({
+			{"phase", memoryUsage.phase},
+			{"residentSize", memoryUsage.residentSize},
+			{"peakResidentSize", memoryUsage.peakResidentSize},
+			{"heapSize", memoryUsage.heapSize},
+			{"allocatedSize", memoryUsage.allocatedSize},
+		});
+	}
+
+	return {
+		{"elapsedTime", elapsedTime},
+		{"nbSolutions", nbSolutions},
+		{"objectiveValue", objectiveValue},
+		{"bestBound", bestBound},
+		{"gap", getGap()},
+		{"improvements", jsonImprovements},
+		{"phase", phase},
+		{"nbRunningSearches", nbRunningSearches},
+		{"memoryUsages", jsonMemoryUsages},
+	};
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QString>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+class QJsonObject;
+
+/** The memory used at the end of a phase of the computation, in megabytes */
+struct PhaseMemoryUsage {
+	QString phase;
+	double residentSize;
+	double peakResidentSize;
+	double heapSize;
+
+	/** Growth of the heap during the phase, negative when the phase frees more than it allocates */
+	double allocatedSize;
+};
+
+/** The progress of the search, with the values of the global objective, which is minimised */
+struct SearchStatistics {
+	/** In seconds, since the beginning of the computation */
+	double elapsedTime = 0;
+
+	int nbSolutions = 0;
+	double objectiveValue = 0;
+
+	/** Lower bound of the global objective, derived from the state and proven by CP-SAT */
+	double bestBound = 0;
+
+	/** The elapsed time and the objective value of the improving solutions, decimated beyond maxNbImprovements */
+	std::vector<std::pair<double, double>> improvements;
+	static constexpr std::size_t maxNbImprovements = 128;
+
+	/** One of "building", "repair", "greedy", "globalSearch", "neighbourhoodSearch", "localSearch" or "finished" */
+	QString phase = "building";
+
+	/** Number of CP-SAT searches currently running */
+	int nbRunningSearches = 0;
+
+	/** One for each phase of the model building, and one for the search */
+	std::vector<PhaseMemoryUsage> memoryUsages;
+
+	void addImprovement(double time, double value);
+	double getGap() const;
+	QJsonObject toJsonObject() const;
+};
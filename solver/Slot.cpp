@@ -2,14 +2,14 @@
 
 #include <QHash>
 
-Slot::Slot(Teacher const &teacher, Timeslot const &timeslot): teacher(teacher), timeslot(timeslot)
+Slot::Slot(Teacher const &teacher, Timeslot const &timeslot): teacher(&teacher), timeslot(timeslot)
 {
 
 }
 
 const Teacher& Slot::getTeacher() const
 {
-	return teacher;
+	return *teacher;
 }
 
 const Timeslot& Slot::getTimeslot() const
@@ -19,5 +19,5 @@ const Timeslot& Slot::getTimeslot() const
 
 size_t std::hash<Slot>::operator()(const Slot& slot) const
 {
-	return std::hash<Teacher>()(slot.getTeacher()) ^ std::hash<Timeslot>()(slot.getTimeslot());
+	return std::hash<Teacher const *>()(&slot.getTeacher()) ^ std::hash<Timeslot>()(slot.getTimeslot());
 }
@@ -8,13 +8,14 @@ class Slot
 {
 	public:
 		Slot(Teacher const &teacher, Timeslot const &timeslot);
+		Slot(Teacher const &&teacher, Timeslot const &timeslot) = delete;
 		const Teacher& getTeacher() const;
 		const Timeslot& getTimeslot() const;
 
 		bool operator==(Slot const &) const = default;
 
 	protected:
-		Teacher teacher;
+		Teacher const *teacher;
 		Timeslot timeslot;
 };
 
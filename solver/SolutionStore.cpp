@@ -0,0 +1,103 @@
+#include "SolutionStore.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QStringList>
+#include <map>
+
+SolutionStore::SolutionStore(QString const &filePath): filePath(filePath)
+{
+	QDir().mkpath(QFileInfo(filePath).absolutePath());
+}
+
+/** Each solution is written on its own line, so that an interrupted write only loses the last one */
+void SolutionStore::append(QByteArray const &fingerprint, QJsonArray const &colles, QJsonArray const &objectiveComputations)
+{
+	QFile file(filePath);
+	if (!file.open(QIODevice::Append)) {
+		qWarning() << "Unable to open the solution store" << filePath;
+		return;
+	}
+
+	QJsonObject const record = {
+		{"fingerprint", QString::fromLatin1(fingerprint)},
+		{"time", QDateTime::currentDateTimeUtc().toString(Qt::ISODate)},
+		{"colles", colles},
+		{"objectiveComputations", objectiveComputations},
+	};
+	file.write(QJsonDocument(record).toJson(QJsonDocument::Compact) + '\n');
+	file.flush();
+}
+
+std::optional<QJsonArray> SolutionStore::getLastColles(QByteArray const &fingerprint) const
+{
+	QFile file(filePath);
+	if (!file.open(QIODevice::ReadOnly)) {
+		return std::nullopt;
+	}
+
+	std::optional<QJsonArray> lastColles;
+	while (!file.atEnd()) {
+		auto const &record = QJsonDocument::fromJson(file.readLine()).object();
+		if (record["fingerprint"].toString().toLatin1() == fingerprint) {
+			lastColles = record["colles"].toArray();
+		}
+	}
+
+	return lastColles;
+}
+
+/** Only keep the last solution of each state */
+void SolutionStore::compact()
+{
+	QFile file(filePath);
+	if (!file.open(QIODevice::ReadOnly)) {
+		return;
+	}
+
+	std::map<QString, QByteArray> lastLineByFingerprint;
+	while (!file.atEnd()) {
+		auto const &line = file.readLine();
+		auto const &record = QJsonDocument::fromJson(line).object();
+		if (!record.isEmpty()) {
+			lastLineByFingerprint[record["fingerprint"].toString()] = line;
+		}
+	}
+	file.close();
+
+	// The compacted file replaces the store in a single rename, so that the store is left untouched on failure
+	QSaveFile compactedFile(filePath);
+	if (!compactedFile.open(QIODevice::WriteOnly)) {
+		qWarning() << "Unable to compact the solution store" << filePath;
+		return;
+	}
+
+	for (auto const &[fingerprint, line]: lastLineByFingerprint) {
+		compactedFile.write(line);
+	}
+
+	if (!compactedFile.commit()) {
+		qWarning() << "Unable to compact the solution store" << filePath << compactedFile.errorString();
+	}
+}
+
+/** The solver parameters are left out, so that a solution still resumes the computation of the same state with other parameters */
+QByteArray SolutionStore::getFingerprint(QJsonObject const &jsonState)
+{
+	auto jsonData = jsonState;
+	jsonData.remove("solverParameters");
+	return QCryptographicHash::hash(QJsonDocument(jsonData).toJson(QJsonDocument::Compact), QCryptographicHash::Sha256).toHex();
+}
+
+QString SolutionStore::getDefaultFilePath()
+{
+	return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/solutions.jsonl";
+}
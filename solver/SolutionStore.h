@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QByteArray>
+#include <QJsonArray>
+#include <QString>
+#include <optional>
+
+class QJsonObject;
+
+/** An append-only file of the improving solutions, so that a computation can be resumed after a restart */
+class SolutionStore
+{
+	public:
+		explicit SolutionStore(QString const &filePath);
+
+		void append(QByteArray const &fingerprint, QJsonArray const &colles, QJsonArray const &objectiveComputations);
+		std::optional<QJsonArray> getLastColles(QByteArray const &fingerprint) const;
+		void compact();
+
+		static QByteArray getFingerprint(QJsonObject const &jsonState);
+		static QString getDefaultFilePath();
+
+	protected:
+		QString filePath;
+};
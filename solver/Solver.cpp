@@ -1,28 +1,53 @@
 #include "Solver.h"
 
 #include <ortools/sat/cp_model.h>
+#include <ortools/util/logging.h>
 #include <ortools/util/time_limit.h>
 #include <QDebug>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QThread>
+#include <QtConcurrent>
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
 #include <numeric>
+#include <optional>
 #include <ranges>
+#include <set>
+#include <thread>
+#include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include "Objective/Objective.h"
 #include "Objective/ObjectiveComputation.h"
+#include "misc.h"
 #include "Colle.h"
+#include "ColloscopeEvaluator.h"
+#include "GreedyHeuristic.h"
+#include "Group.h"
+#include "LocalSearch.h"
+#include "SolverParameters.h"
 #include "State.h"
 #include "Timeslot.h"
 
+using operations_research::SolverLogger;
 using operations_research::TimeLimit;
 using operations_research::sat::BoolVar;
 using operations_research::sat::CpModelBuilder;
+using operations_research::sat::CpModelProto;
 using operations_research::sat::CpSolverResponse;
 using operations_research::sat::CpSolverResponseStats;
 using operations_research::sat::CpSolverStatus;
 using operations_research::sat::CpSolverStatus_Name;
+using operations_research::sat::DecisionStrategyProto;
 using operations_research::sat::LinearExpr;
 using operations_research::sat::Model;
 using operations_research::sat::NewFeasibleSolutionObserver;
+using operations_research::sat::NewSatParameters;
+using operations_research::sat::SatParameters;
 using std::unordered_map;
 using std::vector;
 
@@ -30,33 +55,92 @@ Solver::Solver(State const &state): state(&state)
 {
 }
 
-bool Solver::compute(std::function<void(vector<Colle> const &colles, vector<ObjectiveComputation> const &objectivesValues)> const &solutionFound)
+/** The computation stops right away if `stopComputation` has been called since the last call to `prepareComputation` */
+bool Solver::compute(SolutionFoundCallback const &solutionFound)
+{
+	computationStart = std::chrono::steady_clock::now();
+	lastHeapSize = getMemoryUsage().heapSize;
+	{
+		std::scoped_lock lock(statisticsMutex);
+		statistics = SearchStatistics();
+	}
+
+	bool success = false;
+	try {
+		success = state->getSolverParameters().getEngine() == Engine::LocalSearch
+			? searchLocally(solutionFound)
+			: buildAndSearch(solutionFound)
+		;
+	}
+	catch (ComputationStoppedException const &) {
+		qDebug() << "Computation stopped before the search";
+	}
+
+	setPhase("finished");
+	return success;
+}
+
+bool Solver::buildAndSearch(SolutionFoundCallback const &solutionFound)
 {
 	CpModelBuilder modelBuilder;
 
+	// In periodic mode, only the weeks of the first cycle have their own variables,
+	// and each following week reuses the variables of the corresponding week of the first cycle.
+	int const nbModelledWeeks = isPeriodic() ? getPeriodicCycleDuration() : state->getWeeks().size();
+	auto const &modelledWeeks = state->getWeeks() | std::views::take(nbModelledWeeks);
+
+	// The colles which cannot take place in any solution all share the constant false variable, so that CP-SAT never sees them
+	auto const bestSubjectsCombinations = getBestSubjectsCombinations();
+	auto const &isColleImpossible = getImpossibleColleFilter(bestSubjectsCombinations, nbModelledWeeks);
+	int nbVars = 0;
+	int nbPrunedVars = 0;
+
 	SolverVar isTrioWithTeacherAtTimeslotInWeek;
 	for (auto const &teacher: state->getTeachers()) {
+		throwIfComputationStopped(shouldComputationBeStopped);
+
 		for (auto const &trio: state->getTrios()) {
-			for (auto const &week: state->getWeeks()) {
+			for (int idWeek = 0; idWeek < state->getWeeks().size(); ++idWeek) {
+				auto const &week = state->getWeeks()[idWeek];
+				auto const &modelledWeek = state->getWeeks()[idWeek % nbModelledWeeks];
+
 				for (auto const &timeslot: state->getAvailableTimeslots(teacher, trio, week)) {
-					isTrioWithTeacherAtTimeslotInWeek[trio][teacher][timeslot][week] = modelBuilder.NewBoolVar();
+					bool const isImpossible = isColleImpossible(teacher, trio, idWeek, timeslot);
+					BoolVar var;
+					if (idWeek < nbModelledWeeks) {
+						var = isImpossible ? modelBuilder.FalseVar() : modelBuilder.NewBoolVar();
+						++(isImpossible ? nbPrunedVars : nbVars);
+					}
+					else {
+						// In periodic mode, a colle impossible in any cycle cannot take place in the first one either
+						var = isTrioWithTeacherAtTimeslotInWeek.at(trio).at(teacher).at(timeslot).at(modelledWeek);
+						if (isImpossible) {
+							modelBuilder.FixVariable(var, false);
+						}
+					}
+					isTrioWithTeacherAtTimeslotInWeek[trio][teacher][timeslot][week] = var;
 				}
 			}
 		}
 	}
+	qDebug() << "Modelled weeks:" << nbModelledWeeks << "out of" << state->getWeeks().size();
+	qDebug() << "Pruned variables:" << nbPrunedVars << "out of" << nbVars + nbPrunedVars;
+	logMemoryUsage("variables");
 
 	/***************************/
 	/***** ADD CONSTRAINTS *****/
 	/***************************/
 
 	// Teachers cannot have two trios at the same time
-	for (auto const &week: state->getWeeks()) {
+	for (auto const &week: modelledWeeks) {
+		throwIfComputationStopped(shouldComputationBeStopped);
+
 		for (auto const &teacher: state->getTeachers()) {
 			for (auto const &timeslot: teacher.getAvailableTimeslots()) {
 				vector<BoolVar> collesOfTeacherAtTimeslotInWeek;
 
 				for (auto const &trio: state->getTrios()) {
-					if (trio.getAvailableTimeslotsInWeek(week).contains(timeslot)) {
+					if (state->getAvailableTimeslots(trio, week).contains(timeslot)) {
 						collesOfTeacherAtTimeslotInWeek.push_back(isTrioWithTeacherAtTimeslotInWeek[trio][teacher][timeslot][week]);
 					}
 				}
@@ -67,9 +151,11 @@ bool Solver::compute(std::function<void(vector<Colle> const &colles, vector<Obje
 	}
 
 	// Trios cannot have two colles at the same time
-	for (auto const &week: state->getWeeks()) {
+	for (auto const &week: modelledWeeks) {
+		throwIfComputationStopped(shouldComputationBeStopped);
+
 		for (auto const &trio: state->getTrios()) {
-			for (auto const &timeslot: trio.getAvailableTimeslotsInWeek(week)) {
+			for (auto const &timeslot: state->getAvailableTimeslots(trio, week)) {
 				vector<BoolVar> collesOfTriosAtTimeslotInWeek;
 
 				for (auto const &teacher: state->getTeachers()) {
@@ -85,6 +171,8 @@ bool Solver::compute(std::function<void(vector<Colle> const &colles, vector<Obje
 
 	// Trios must have each subject with the appropriate frequency, regularly distributed amongst weeks
 	for (auto const &trio: state->getTrios()) {
+		throwIfComputationStopped(shouldComputationBeStopped);
+
 		for (auto const &subject: state->getSubjects()) {
 			// We go through all consecutives sets of `frequency` weeks,
 			// which exclude some of the last weeks as starting point of the set.
@@ -92,7 +180,7 @@ bool Solver::compute(std::function<void(vector<Colle> const &colles, vector<Obje
 				vector<BoolVar> collesOfTrioInSubjectInSetOfWeeks;
 
 				for (auto const &week: state->getWeeks() | std::views::drop(idStartingWeek) | std::views::take(subject.getFrequency())) {
-					for (auto const &teacher: state->getTeachersOfSubject(subject)) {
+					for (Teacher const &teacher: state->getTeachersOfSubject(subject)) {
 						for (auto const &timeslot: state->getAvailableTimeslots(teacher, trio, week)) {
 							collesOfTrioInSubjectInSetOfWeeks.push_back(isTrioWithTeacherAtTimeslotInWeek[trio][teacher][timeslot][week]);
 						}
@@ -105,8 +193,9 @@ bool Solver::compute(std::function<void(vector<Colle> const &colles, vector<Obje
 	}
 
 	// Trios must have a regular number of subjects each week
-	auto bestSubjectsCombinations = getBestSubjectsCombinations();
 	for (auto const &trio: state->getTrios()) {
+		throwIfComputationStopped(shouldComputationBeStopped);
+
 		vector<BoolVar> subjectsCombinationVars;
 
 		for (auto const &subjectsCombination: bestSubjectsCombinations) {
@@ -116,7 +205,7 @@ bool Solver::compute(std::function<void(vector<Colle> const &colles, vector<Obje
 			for (auto const &[subject, week]: subjectsCombination) {
 				vector<BoolVar> collesOfTrioInSubjectInWeek;
 
-				for (auto const &teacher: state->getTeachersOfSubject(subject)) {
+				for (Teacher const &teacher: state->getTeachersOfSubject(subject)) {
 					for (auto const &timeslot: state->getAvailableTimeslots(teacher, trio, week)) {
 						collesOfTrioInSubjectInWeek.push_back(isTrioWithTeacherAtTimeslotInWeek[trio][teacher][timeslot][week]);
 					}
@@ -131,13 +220,15 @@ bool Solver::compute(std::function<void(vector<Colle> const &colles, vector<Obje
 
 	// Trios must have time to eat lunch
 	auto const &lunchTimeRange = state->getLunchTimeRange();
-	for (auto const &week: state->getWeeks()) {
+	for (auto const &week: modelledWeeks) {
+		throwIfComputationStopped(shouldComputationBeStopped);
+
 		for (auto const &day: Timeslot::days) {
 			for (auto const &trio: state->getTrios()) {
 				int nbAvailableTimeslotsOfTrioDuringLunchTimeInDayAndWeek = 0;
 				LinearExpr nbCollesOfTrioDuringLunchTimeInDayAndWeek;
 
-				for (auto const &timeslot: trio.getAvailableTimeslotsInWeek(week)) {
+				for (auto const &timeslot: state->getAvailableTimeslots(trio, week)) {
 					if (timeslot.getDay() == day && timeslot.getHour() >= lunchTimeRange.first && timeslot.getHour() < lunchTimeRange.second) {
 						++nbAvailableTimeslotsOfTrioDuringLunchTimeInDayAndWeek;
 
@@ -156,6 +247,8 @@ bool Solver::compute(std::function<void(vector<Colle> const &colles, vector<Obje
 
 	// Teachers must have colles according to their weekly availability frequency
 	for (auto const &teacher: state->getTeachers() | std::views::filter([](auto const &teacher) { return teacher.getWeeklyAvailabilityFrequency() > 1; })) {
+		throwIfComputationStopped(shouldComputationBeStopped);
+
 		unordered_map<Week, BoolVar> hasTeacherCollesInWeek;
 
 		for (auto const &week: state->getWeeks()) {
@@ -186,6 +279,8 @@ bool Solver::compute(std::function<void(vector<Colle> const &colles, vector<Obje
 
 	// Teachers must have colles according to the expected mean weekly volume
 	for (auto const &teacher: state->getTeachers() | std::views::filter(&Teacher::hasMeanWeeklyVolume)) {
+		throwIfComputationStopped(shouldComputationBeStopped);
+
 		LinearExpr nbCollesOfTeacher;
 
 		for (auto const &week: state->getWeeks()) {
@@ -206,53 +301,565 @@ bool Solver::compute(std::function<void(vector<Colle> const &colles, vector<Obje
 		}
 	}
 
+	// Redundant constraints, implied by the previous ones, so that CP-SAT propagates more and finds a first solution sooner
+	if (state->getSolverParameters().areRedundantConstraintsEnabled()) {
+		addRedundantConstraints(modelBuilder, isTrioWithTeacherAtTimeslotInWeek, bestSubjectsCombinations);
+	}
+
+	logMemoryUsage("constraints");
+
 	/****************************/
 	/***** ADD OPTIMISATION *****/
 	/****************************/
 
+	// The lower bounds derived from the state spare CP-SAT from discovering them, so that it proves the optimality sooner
 	std::vector<ObjectiveComputation> objectiveComputations;
 	for (auto const &objective: state->getObjectives()) {
-		objectiveComputations.push_back(objective->compute(state, isTrioWithTeacherAtTimeslotInWeek, modelBuilder));
+		auto &objectiveComputation = objectiveComputations.emplace_back(objective->compute(state, isTrioWithTeacherAtTimeslotInWeek, modelBuilder, shouldComputationBeStopped));
+		objectiveComputation.setLowerBound(objective->getLowerBound(state));
+		if (objectiveComputation.getLowerBound() > 0 && !objectiveComputation.isLazy()) {
+			modelBuilder.AddGreaterOrEqual(objectiveComputation.getExpression(), objectiveComputation.getLowerBound());
+		}
 	};
+	logMemoryUsage("objectives");
 
+	// The lazy objectives only have part of their terms in the model, the other ones being added once a solution violates them
+	bool const isLazy = std::ranges::any_of(objectiveComputations, &ObjectiveComputation::isLazy);
+
+	// In lexicographic mode, each objective is multiplied by a factor greater than the maximal value of the less important ones,
+	// whereas in weighted-sum mode, it is only multiplied by its weight.
+	bool const isWeightedSum = state->getSolverParameters().getObjectiveMode() == ObjectiveMode::WeightedSum;
 	LinearExpr globalObjectiveExpression;
-	unsigned long long globalObjectiveFactor = 1;
-	for (auto const &objectiveComputation: objectiveComputations | std::views::reverse) {
-		qDebug() << "Objective" << objectiveComputation.getObjective()->getName() << ":";
-		qDebug() << "\tMaximal value" << objectiveComputation.getMaxValue();
-		qDebug() << "\tGlobal factor" << globalObjectiveFactor;
-		globalObjectiveExpression += globalObjectiveFactor * objectiveComputation.getExpression();
-		globalObjectiveFactor *= objectiveComputation.getMaxValue() + 1;
-	}
-	qDebug() << "Global objective:";
-	qDebug() << "\tMaximal value" << globalObjectiveFactor;
-	modelBuilder.Minimize(globalObjectiveExpression);
+	vector<unsigned long long> globalObjectiveFactors(objectiveComputations.size());
+	auto const &setGlobalObjective = [&]() {
+		globalObjectiveExpression = LinearExpr();
+		unsigned long long globalObjectiveFactor = 1;
+		unsigned long long globalObjectiveMaxValue = 0;
+		unsigned long long globalObjectiveLowerBound = 0;
+		for (int idObjective = objectiveComputations.size() - 1; idObjective >= 0; --idObjective) {
+			auto const &objectiveComputation = objectiveComputations[idObjective];
+			auto const factor = isWeightedSum ? state->getObjectiveWeight(objectiveComputation.getObjective()) : globalObjectiveFactor;
+			qDebug() << "Objective" << objectiveComputation.getObjective()->getName() << ":";
+			qDebug() << "\tMaximal value" << objectiveComputation.getMaxValue();
+			qDebug() << "\tLower bound" << objectiveComputation.getLowerBound();
+			qDebug() << "\tGlobal factor" << factor;
+			globalObjectiveExpression += factor * objectiveComputation.getExpression();
+			globalObjectiveMaxValue += factor * objectiveComputation.getMaxValue();
+			globalObjectiveLowerBound += factor * objectiveComputation.getLowerBound();
+			globalObjectiveFactor *= objectiveComputation.getMaxValue() + 1;
+			globalObjectiveFactors[idObjective] = factor;
+		}
+		qDebug() << "Global objective:";
+		qDebug() << "\tMaximal value" << globalObjectiveMaxValue;
+		qDebug() << "\tLower bound" << globalObjectiveLowerBound;
+		// The bound proven in a previous lazy round still holds, as the terms added since then can only increase the objective
+		{
+			std::scoped_lock lock(statisticsMutex);
+			statistics.bestBound = std::max<double>(statistics.bestBound, globalObjectiveLowerBound);
+		}
+		modelBuilder.Minimize(globalObjectiveExpression);
+	};
+	setGlobalObjective();
 
-	shouldComputationBeStopped = false;
+	throwIfComputationStopped(shouldComputationBeStopped);
+	auto const colleVars = getColleVars(isTrioWithTeacherAtTimeslotInWeek);
 
-	Model model;
-	model.GetOrCreate<TimeLimit>()->RegisterExternalBooleanAsLimit(&shouldComputationBeStopped);
-	model.Add(NewFeasibleSolutionObserver([&] (auto const &response) {
+	// The builder and the nested maps of variables are not needed anymore, so the proto is moved out instead of copied,
+	// unless lazy terms may still be added to the model.
+	CpModelProto modelProto;
+	if (isLazy) {
+		modelProto = modelBuilder.Proto();
+	}
+	else {
+		modelProto = std::move(*modelBuilder.MutableProto());
+		isTrioWithTeacherAtTimeslotInWeek = SolverVar();
+	}
+	logMemoryUsage("model");
+
+	unordered_map<int, bool> previousValues;
+	if (!previousColles.empty()) {
+		previousValues = getVarValues(colleVars, previousColles);
+	}
+
+	// Set when the last solution has a lazy objective greater than its value in the model, because of the terms still missing from it
+	bool hasMissingLazyTerms = false;
+
+	// Each lazy round starts a new search, whose first solutions may be worse than the ones of the previous rounds, so they are not published
+	std::optional<double> bestPublishedObjectiveValue;
+	auto const publishSolution = [&](CpSolverResponse const &response) {
 		qDebug() << "Duration :" << 1000*response.wall_time() << "ms";
-		for (auto &objectiveComputation: objectiveComputations) {
+		auto const &colles = getColles(response, colleVars);
+
+		// The model only knows the lazy terms added so far, so the actual values of the lazy objectives are computed natively,
+		// whereas the bound proven by CP-SAT on the partial objective still holds for the complete one.
+		std::optional<ColloscopeEvaluator> evaluator;
+		if (isLazy) {
+			evaluator.emplace(*state, colles);
+		}
+
+		hasMissingLazyTerms = false;
+		double objectiveValue = 0;
+		for (int idObjective = 0; idObjective < objectiveComputations.size(); ++idObjective) {
+			auto &objectiveComputation = objectiveComputations[idObjective];
 			objectiveComputation.evaluate(response);
+			if (objectiveComputation.isLazy()) {
+				int const value = evaluator->getObjectiveValue(objectiveComputation.getObjective()).value();
+				hasMissingLazyTerms = hasMissingLazyTerms || value > objectiveComputation.getValue();
+				objectiveComputation.setValue(value);
+			}
+
+			objectiveValue += globalObjectiveFactors[idObjective] * objectiveComputation.getValue();
 			qDebug() << "\tObjective" << objectiveComputation.getObjective()->getName() << ":" << objectiveComputation.getValue();
 		}
-		solutionFound(getColles(response, isTrioWithTeacherAtTimeslotInWeek), objectiveComputations);
-	}));
-	auto response = SolveCpModel(modelBuilder.Build(), &model);
 
-	qDebug().noquote() << QString::fromStdString(CpSolverResponseStats(response)).replace("\n", "\n\t");
+		if (!isLazy) {
+			objectiveValue = response.objective_value();
+		}
+		if (bestPublishedObjectiveValue.has_value() && objectiveValue >= bestPublishedObjectiveValue.value()) {
+			return;
+		}
+		bestPublishedObjectiveValue = objectiveValue;
+
+		previousColles.clear();
+		for (auto const &colle: colles) {
+			previousColles.insert(getColleIds(colle));
+		}
+
+		solutionFound(colles, objectiveComputations, recordImprovement(objectiveValue, response.best_objective_bound()));
+	};
+
+	std::jthread convergenceWatcher([this](std::stop_token stopToken) { watchConvergence(stopToken); });
+
+	// The previous solution is used as a starting point, and is first repaired when only a few entities have changed
+	auto const &parameters = state->getSolverParameters();
+	std::optional<CpSolverResponse> initialResponse;
+	auto const &setSolutionHint = [&](auto const &values) {
+		auto *solutionHint = modelProto.mutable_solution_hint();
+		solutionHint->Clear();
+		for (auto const &[varIndex, value]: values) {
+			solutionHint->add_vars(varIndex);
+			solutionHint->add_values(value);
+		}
+	};
+	auto const &getResponseValues = [](CpSolverResponse const &response) {
+		vector<std::pair<int, std::int64_t>> values;
+		for (int varIndex = 0; varIndex < response.solution_size(); ++varIndex) {
+			values.emplace_back(varIndex, response.solution(varIndex));
+		}
+		return values;
+	};
+
+	if (!previousValues.empty()) {
+		setSolutionHint(previousValues);
+
+		if (!state->getChanges().isStructural) {
+			setPhase("repair");
+			auto const &response = repairPreviousSolution(modelProto, colleVars, previousValues);
+			if (response.status() == CpSolverStatus::FEASIBLE || response.status() == CpSolverStatus::OPTIMAL) {
+				qDebug() << "Previous solution repaired";
+				initialResponse = response;
+				publishSolution(response);
+				setSolutionHint(getResponseValues(response));
+			}
+		}
+	}
+	// Without any previous solution, a greedy one is shown right away and used as the starting point instead
+	else if (parameters.isGreedyHeuristicEnabled()) {
+		setPhase("greedy");
+		std::set<ColleIds> greedyColleIds;
+		for (auto const &colle: GreedyHeuristic(*state).compute(bestSubjectsCombinations, nbModelledWeeks)) {
+			greedyColleIds.insert(getColleIds(colle));
+		}
+
+		auto const &greedyValues = getVarValues(colleVars, greedyColleIds);
+		setSolutionHint(greedyValues);
+
+		// Some colles may be missing, and are then added by CP-SAT; if they cannot be, the greedy solution is only a hint
+		auto const &response = completeGreedySolution(modelProto, greedyValues);
+		if (response.status() == CpSolverStatus::FEASIBLE || response.status() == CpSolverStatus::OPTIMAL) {
+			qDebug() << "Greedy solution found with" << greedyColleIds.size() << "colles";
+			initialResponse = response;
+			publishSolution(response);
+			setSolutionHint(getResponseValues(response));
+		}
+	}
+
+	// A search stops as soon as its best solution has terms missing from the model, instead of improving a partial objective until its end
+	auto const &shouldSearchBeRestarted = [&]() {
+		return hasMissingLazyTerms;
+	};
+
+	setPhase("globalSearch");
+	auto response = searchGlobally(modelProto, colleVars, globalObjectiveExpression, initialResponse ? &initialResponse.value() : nullptr, publishSolution, shouldSearchBeRestarted);
+
+	// The terms violated by the best solution are added to the model, which is then searched again from this solution,
+	// until the best solution does not violate any term missing from the model.
+	while (isLazy && !shouldComputationBeStopped && (response.status() == CpSolverStatus::FEASIBLE || response.status() == CpSolverStatus::OPTIMAL)) {
+		auto const &colles = getColles(response, colleVars);
+		int nbAddedTerms = 0;
+		for (auto &objectiveComputation: objectiveComputations) {
+			nbAddedTerms += objectiveComputation.addLazyTerms(colles, isTrioWithTeacherAtTimeslotInWeek, modelBuilder);
+		}
+		if (nbAddedTerms == 0) {
+			break;
+		}
+
+		qDebug() << "Lazy terms added:" << nbAddedTerms;
+		setGlobalObjective();
+		modelProto = modelBuilder.Proto();
+		setSolutionHint(getResponseValues(response));
+
+		// The objective value of the previous response only covers the previous terms, so it cannot be the starting point of the search
+		auto const &lazyResponse = searchGlobally(modelProto, colleVars, globalObjectiveExpression, nullptr, publishSolution, shouldSearchBeRestarted);
+		if (lazyResponse.status() != CpSolverStatus::FEASIBLE && lazyResponse.status() != CpSolverStatus::OPTIMAL) {
+			break;
+		}
+		response = lazyResponse;
+	}
+
+	// The neighbourhood search compares the objective values of the model, which leave out the lazy terms not added yet
+	bool const hasSolution = response.status() == CpSolverStatus::FEASIBLE || response.status() == CpSolverStatus::OPTIMAL;
+	if (hasSolution && response.status() != CpSolverStatus::OPTIMAL && parameters.isNeighbourhoodSearchEnabled() && !isLazy) {
+		setPhase("neighbourhoodSearch");
+		searchNeighbourhoods(modelProto, colleVars, response, publishSolution);
+	}
+	logMemoryUsage("search");
+
+	return hasSolution;
+}
+
+/**
+ * Add the aggregated consequences of the constraints, which CP-SAT would otherwise have to discover by itself:
+ * - a trio has each subject every `frequency` weeks, so a number of times close to the number of weeks divided by the frequency;
+ * - a trio never has more colles in a week than the number of subjects in the busiest week of the best subjects combinations;
+ * - a subject has as many colles as its trios need, and as its teachers give when they all have a volume;
+ * - a teacher uses each of its timeslots at most once in each week where it can have colles.
+ */
+void Solver::addRedundantConstraints(
+	CpModelBuilder &modelBuilder,
+	SolverVar const &isTrioWithTeacherAtTimeslotInWeek,
+	vector<unordered_map<Subject, Week>> const &bestSubjectsCombinations
+) const
+{
+	auto const &weeks = state->getWeeks();
+	int const nbWeeks = weeks.size();
+	int const nbTrios = state->getTrios().size();
+
+	// A subject without any complete set of `frequency` weeks may take place outside of its combination
+	auto const &isRegular = [&](Subject const &subject) { return subject.getFrequency() <= nbWeeks; };
+	bool const areAllSubjectsRegular = std::ranges::all_of(state->getSubjects(), isRegular);
+	int const maxNbSubjectsInWeek = bestSubjectsCombinations.empty() ? 0 : getMaxNbSubjectsInWeek(bestSubjectsCombinations.front());
+
+	for (auto const &trio: state->getTrios()) {
+		throwIfComputationStopped(shouldComputationBeStopped);
+
+		if (areAllSubjectsRegular && !bestSubjectsCombinations.empty()) {
+			for (auto const &week: weeks) {
+				LinearExpr nbCollesOfTrioInWeek;
+				for (auto const &teacher: state->getTeachers()) {
+					for (auto const &timeslot: state->getAvailableTimeslots(teacher, trio, week)) {
+						nbCollesOfTrioInWeek += isTrioWithTeacherAtTimeslotInWeek.at(trio).at(teacher).at(timeslot).at(week);
+					}
+				}
+
+				modelBuilder.AddLessOrEqual(nbCollesOfTrioInWeek, maxNbSubjectsInWeek);
+			}
+		}
+
+		for (auto const &subject: state->getSubjects() | std::views::filter(isRegular)) {
+			LinearExpr nbCollesOfTrioInSubject;
+			for (Teacher const &teacher: state->getTeachersOfSubject(subject)) {
+				for (auto const &week: weeks) {
+					for (auto const &timeslot: state->getAvailableTimeslots(teacher, trio, week)) {
+						nbCollesOfTrioInSubject += isTrioWithTeacherAtTimeslotInWeek.at(trio).at(teacher).at(timeslot).at(week);
+					}
+				}
+			}
+
+			modelBuilder.AddGreaterOrEqual(nbCollesOfTrioInSubject, nbWeeks / subject.getFrequency());
+			modelBuilder.AddLessOrEqual(nbCollesOfTrioInSubject, divideCeil(nbWeeks, subject.getFrequency()));
+		}
+	}
+
+	for (auto const &subject: state->getSubjects()) {
+		throwIfComputationStopped(shouldComputationBeStopped);
+
+		LinearExpr nbCollesInSubject;
+		int minNbCollesOfTeachers = 0;
+		int maxNbCollesOfTeachers = 0;
+		bool haveAllTeachersVolume = true;
+		for (Teacher const &teacher: state->getTeachersOfSubject(subject)) {
+			for (auto const &trio: state->getTrios()) {
+				for (auto const &week: weeks) {
+					for (auto const &timeslot: state->getAvailableTimeslots(teacher, trio, week)) {
+						nbCollesInSubject += isTrioWithTeacherAtTimeslotInWeek.at(trio).at(teacher).at(timeslot).at(week);
+					}
+				}
+			}
+
+			if (teacher.hasMeanWeeklyVolume()) {
+				auto const &totalVolume = teacher.getTotalVolume(nbWeeks);
+				minNbCollesOfTeachers += totalVolume.value;
+				maxNbCollesOfTeachers += totalVolume.isExact ? totalVolume.value : totalVolume.value + 1;
+			}
+			else {
+				haveAllTeachersVolume = false;
+			}
+		}
+
+		if (isRegular(subject)) {
+			modelBuilder.AddGreaterOrEqual(nbCollesInSubject, nbTrios * (nbWeeks / subject.getFrequency()));
+			modelBuilder.AddLessOrEqual(nbCollesInSubject, nbTrios * divideCeil(nbWeeks, subject.getFrequency()));
+		}
+
+		if (haveAllTeachersVolume) {
+			modelBuilder.AddGreaterOrEqual(nbCollesInSubject, minNbCollesOfTeachers);
+			modelBuilder.AddLessOrEqual(nbCollesInSubject, maxNbCollesOfTeachers);
+		}
+	}
+
+	for (auto const &teacher: state->getTeachers()) {
+		throwIfComputationStopped(shouldComputationBeStopped);
+
+		int const maxNbWeeksWithColles = divideCeil(nbWeeks, teacher.getWeeklyAvailabilityFrequency());
+		for (auto const &timeslot: teacher.getAvailableTimeslots()) {
+			LinearExpr nbCollesOfTeacherAtTimeslot;
+			for (auto const &week: weeks) {
+				for (auto const &trio: state->getTrios()) {
+					if (state->getAvailableTimeslots(trio, week).contains(timeslot)) {
+						nbCollesOfTeacherAtTimeslot += isTrioWithTeacherAtTimeslotInWeek.at(trio).at(teacher).at(timeslot).at(week);
+					}
+				}
+			}
+
+			modelBuilder.AddLessOrEqual(nbCollesOfTeacherAtTimeslot, maxNbWeeksWithColles);
+		}
+	}
+}
+
+/**
+ * Search with the local search engine, starting from a greedy solution.
+ * The objectives are evaluated natively, so the model is never built.
+ */
+bool Solver::searchLocally(SolutionFoundCallback const &solutionFound)
+{
+	setPhase("greedy");
+	auto const &bestSubjectsCombinations = getBestSubjectsCombinations();
+	auto const &initialColles = GreedyHeuristic(*state).compute(bestSubjectsCombinations, state->getWeeks().size());
+
+	// Only the objectives known to the evaluator are reported
+	LocalSearch localSearch(*state, bestSubjectsCombinations);
+	ColloscopeEvaluator const emptyEvaluator(*state, {});
+	std::vector<ObjectiveComputation> objectiveComputations;
+	for (auto const &objective: state->getObjectives()) {
+		if (emptyEvaluator.getObjectiveValue(objective).has_value()) {
+			objectiveComputations.emplace_back(objective, LinearExpr(), 0).setLowerBound(objective->getLowerBound(state));
+		}
+	}
+	{
+		std::scoped_lock lock(statisticsMutex);
+		statistics.bestBound = localSearch.getLowerBound();
+	}
+
+	std::jthread convergenceWatcher([this](std::stop_token stopToken) { watchConvergence(stopToken); });
+
+	bool hasSolution = false;
+	setPhase("localSearch");
+	localSearch.run(initialColles, shouldComputationBeStopped, [&](ColloscopeEvaluator const &evaluator, double cost) {
+		qDebug() << "Local search improved the objective to" << cost;
+		evaluator.setObjectiveValues(objectiveComputations);
+		hasSolution = true;
+		solutionFound(evaluator.getColles(), objectiveComputations, recordImprovement(cost, 0));
+	});
+
+	return hasSolution;
+}
+
+/** Update the statistics with a new improving solution, whatever the engine which found it */
+SearchStatistics Solver::recordImprovement(double objectiveValue, double bestBound)
+{
+	SearchStatistics currentStatistics;
+	{
+		std::scoped_lock lock(statisticsMutex);
+		lastImprovement = std::chrono::steady_clock::now();
+		statistics.elapsedTime = std::chrono::duration<double>(lastImprovement - computationStart).count();
+		statistics.nbSolutions++;
+		statistics.objectiveValue = objectiveValue;
+		statistics.bestBound = std::max(statistics.bestBound, bestBound);
+		statistics.addImprovement(statistics.elapsedTime, statistics.objectiveValue);
+		currentStatistics = statistics;
+	}
+	qDebug() << "\tGap:" << currentStatistics.getGap();
+
+	return currentStatistics;
+}
+
+/** Can be called from any thread, the elapsed time being the one since the beginning of the computation */
+SearchStatistics Solver::getStatistics() const
+{
+	std::scoped_lock lock(statisticsMutex);
+	auto currentStatistics = statistics;
+	currentStatistics.elapsedTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - computationStart).count();
+
+	return currentStatistics;
+}
+
+void Solver::setPhase(QString const &phase)
+{
+	std::scoped_lock lock(statisticsMutex);
+	statistics.phase = phase;
+}
+
+/** Reads the best bound from the "#Bound" lines of the CP-SAT log, written as soon as it improves, e.g. "#Bound 1.25s best:120 next:[42,119] ..." */
+void Solver::updateStatisticsFromLog(std::string const &message)
+{
+	auto const boundPosition = message.find("next:[");
+	if (!message.starts_with("#Bound") || boundPosition == std::string::npos) {
+		return;
+	}
+
+	double bound;
+	try {
+		bound = std::stod(message.substr(boundPosition + 6));
+	}
+	catch (std::exception const &) {
+		return;
+	}
+
+	std::scoped_lock lock(statisticsMutex);
+	statistics.bestBound = std::max(statistics.bestBound, bound);
+}
+
+CpSolverResponse Solver::runSearch(CpModelProto const &modelProto, Model &model)
+{
+	{
+		std::scoped_lock lock(statisticsMutex);
+		statistics.nbRunningSearches++;
+	}
+
+	auto response = SolveCpModel(modelProto, &model);
+
+	std::scoped_lock lock(statisticsMutex);
+	statistics.nbRunningSearches--;
+	return response;
+}
+
+/** Stops the computation as soon as it has converged enough according to the solver parameters */
+void Solver::watchConvergence(std::stop_token stopToken)
+{
+	auto const &parameters = state->getSolverParameters();
+	auto const stallTimeLimit = std::chrono::duration<double>(parameters.getStallTimeLimit());
+
+	while (!stopToken.stop_requested() && !shouldComputationBeStopped) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+		std::scoped_lock lock(statisticsMutex);
+		if (statistics.nbSolutions == 0) {
+			continue;
+		}
+
+		if (statistics.getGap() <= parameters.getRelativeGapLimit()) {
+			qDebug() << "Computation stopped, as the gap" << statistics.getGap() << "is under the limit";
+			shouldComputationBeStopped = true;
+		}
+		else if (parameters.getStallTimeLimit() > 0 && std::chrono::steady_clock::now() - lastImprovement > stallTimeLimit) {
+			qDebug() << "Computation stopped, as there has been no improvement for" << stallTimeLimit.count() << "s";
+			shouldComputationBeStopped = true;
+		}
+	}
+}
 
-	return response.status() == CpSolverStatus::FEASIBLE || response.status() == CpSolverStatus::OPTIMAL;
+/**
+ * Logs the memory used at the end of a phase, along with the heap allocated during it, and records them in the statistics.
+ * Past the memory budget, the computation is stopped, as the next phases would only need more memory.
+ */
+void Solver::logMemoryUsage(QString const &phase)
+{
+	auto const &memoryUsage = getMemoryUsage();
+	PhaseMemoryUsage phaseMemoryUsage = {phase, memoryUsage.residentSize, memoryUsage.peakResidentSize, memoryUsage.heapSize, memoryUsage.heapSize - lastHeapSize};
+	lastHeapSize = memoryUsage.heapSize;
+
+	qDebug().nospace()
+		<< "Memory after the " << phase << ": "
+		<< phaseMemoryUsage.residentSize << " MB resident, "
+		<< phaseMemoryUsage.peakResidentSize << " MB peak, "
+		<< phaseMemoryUsage.heapSize << " MB allocated, "
+		<< phaseMemoryUsage.allocatedSize << " MB during the phase"
+	;
+
+	{
+		std::scoped_lock lock(statisticsMutex);
+		statistics.memoryUsages.push_back(phaseMemoryUsage);
+	}
+
+	// The peak covers the previous computations of the process too, so only the current size is compared to the budget
+	auto const memoryBudget = state->getSolverParameters().getMemoryBudget();
+	if (memoryBudget > 0 && memoryUsage.residentSize > memoryBudget) {
+		qWarning().nospace() << "The memory usage of " << memoryUsage.residentSize << " MB exceeds the budget of " << memoryBudget << " MB, so the computation is stopped";
+		shouldComputationBeStopped = true;
+	}
 }
 
-/** @bug Error in OR-Tools when the computation is stopped too early */
+/**
+ * Allow a new computation after a stopped one.
+ * It is called by the caller before scheduling the computation in another thread, instead of by the computation itself,
+ * so that a stop requested before the computation actually starts is not lost.
+ */
+void Solver::prepareComputation()
+{
+	shouldComputationBeStopped = false;
+}
+
+/**
+ * Can be called at any time, from any thread: the model building stops at its next checkpoint,
+ * and the running searches as soon as CP-SAT checks its time limit.
+ */
 void Solver::stopComputation()
 {
 	shouldComputationBeStopped = true;
 }
 
+/**
+ * The periodic mode is only used when requested, and when the colloscope of the first cycle can be repeated as is for the whole year:
+ * - the availabilities of the trios are the same every week;
+ * - the year is made of whole cycles;
+ * - the volume of each teacher is a multiple of the number of cycles, as each cycle has the same colles.
+ */
+bool Solver::isPeriodic() const
+{
+	if (!state->getSolverParameters().isPeriodicModeEnabled() || std::ranges::any_of(state->getGroups(), &Group::hasNextGroup)) {
+		return false;
+	}
+
+	int const nbWeeks = state->getWeeks().size();
+	int const cycleDuration = getPeriodicCycleDuration();
+	if (nbWeeks <= cycleDuration || nbWeeks % cycleDuration != 0) {
+		return false;
+	}
+
+	int const nbCycles = nbWeeks / cycleDuration;
+	return std::ranges::all_of(state->getTeachers() | std::views::filter(&Teacher::hasMeanWeeklyVolume), [&](auto const &teacher) {
+		auto const &totalVolume = teacher.getTotalVolume(nbWeeks);
+		int const maxVolume = totalVolume.isExact ? totalVolume.value : totalVolume.value + 1;
+		return static_cast<int>(divideCeil(totalVolume.value, nbCycles)) * nbCycles <= maxVolume;
+	});
+}
+
+/** Use the given colles, in the format of `Colle::toJsonObject`, as the starting point of the next computation */
+void Solver::setPreviousColles(QJsonArray const &jsonColles)
+{
+	previousColles.clear();
+	for (auto const &jsonColle: jsonColles) {
+		auto const &jsonColleObject = jsonColle.toObject();
+		previousColles.emplace(
+			jsonColleObject["teacherId"].toString(),
+			jsonColleObject["trioId"].toInt(),
+			jsonColleObject["weekId"].toInt(),
+			Timeslot(jsonColleObject["timeslot"].toObject())
+		);
+	}
+}
+
 int Solver::getCycleDuration() const
 {
 	int cycleDuration = 1;
@@ -263,8 +870,18 @@ int Solver::getCycleDuration() const
 	return cycleDuration;
 }
 
+/** The weeks after which both the subjects of the trios and the weeks with colles of the teachers can start again */
+int Solver::getPeriodicCycleDuration() const
+{
+	int cycleDuration = getCycleDuration();
+	for (auto const &teacher: state->getTeachers()) {
+		cycleDuration = std::lcm(cycleDuration, teacher.getWeeklyAvailabilityFrequency());
+	}
+
+	return cycleDuration;
+}
+
 /** @todo There is surely a more clever way to do all this */
-/** @todo Throw an error if there is no acceptable subjects combination */
 vector<std::unordered_map<Subject, Week>> Solver::getBestSubjectsCombinations() const
 {
 	// Create all possible combinations
@@ -274,6 +891,8 @@ vector<std::unordered_map<Subject, Week>> Solver::getBestSubjectsCombinations()
 		possibleCombinations.clear();
 
 		for (auto const &combination: lastPossibleCombinations) {
+			throwIfComputationStopped(shouldComputationBeStopped);
+
 			for (auto const &week: state->getWeeks() | std::views::take(subject.getFrequency())) {
 				auto newCombination = combination;
 				newCombination.emplace(subject, week);
@@ -282,12 +901,6 @@ vector<std::unordered_map<Subject, Week>> Solver::getBestSubjectsCombinations()
 		}
 	}
 
-	auto const &isSubjectInWeek = [&](auto const combination, auto const &subject, auto const &week) {
-		auto const &startingWeek = combination.at(subject);
-		int distance = week.getId() - startingWeek.getId();
-		return distance >= 0 && distance % subject.getFrequency() == 0;
-	};
-
 	// Remove the forbidden combinations
 	int cycleDuration = getCycleDuration();
 	if (!state->getForbiddenSubjectsCombination().empty()) {
@@ -300,19 +913,15 @@ vector<std::unordered_map<Subject, Week>> Solver::getBestSubjectsCombinations()
 		});
 	}
 
+	// Without any week, or with a forbidden combination which is always there, no combination is left, and the model is infeasible
+	if (possibleCombinations.empty()) {
+		return {};
+	}
+
 	// Calculate the maximal numbers of simultaneous subjects in a week for each combination
 	vector<int> maxSubjectsInCombination;
 	for (auto const &combination: possibleCombinations) {
-		int maxSubjects = 0;
-		for (auto const &week: state->getWeeks() | std::views::take(cycleDuration)) {
-			int nbSubjects = std::ranges::count_if(state->getSubjects(), [&](auto const &subject) {
-				return isSubjectInWeek(combination, subject, week);
-			});
-
-			maxSubjects = std::max(maxSubjects, nbSubjects);
-		}
-
-		maxSubjectsInCombination.push_back(maxSubjects);
+		maxSubjectsInCombination.push_back(getMaxNbSubjectsInWeek(combination));
 	}
 
 	// Keep only the combinations with the minimal maximal
@@ -327,20 +936,542 @@ vector<std::unordered_map<Subject, Week>> Solver::getBestSubjectsCombinations()
 	return bestCombinations;
 }
 
-vector<Colle> Solver::getColles(CpSolverResponse const &response, SolverVar const &isTrioWithTeacherAtTimeslotInWeek) const
+/**
+ * The colles which cannot take place in any solution, so that their variables can be left out of the model:
+ * - a trio only has a subject in the weeks given by one of the best subjects combinations, `frequency` weeks apart;
+ * - a teacher with an exact total volume of zero has no colle at all;
+ * - a trio with a single available timeslot during lunch time in a day must keep it free to eat.
+ */
+std::function<bool(Teacher const &teacher, Trio const &trio, int idWeek, Timeslot const &timeslot)> Solver::getImpossibleColleFilter(
+	vector<unordered_map<Subject, Week>> const &bestSubjectsCombinations,
+	int nbModelledWeeks
+) const
+{
+	auto const &weeks = state->getWeeks();
+	int const nbWeeks = weeks.size();
+
+	// Without any complete set of `frequency` weeks, nothing prevents a subject from taking place outside of its combination
+	unordered_map<Subject, std::set<int>> possiblePhasesBySubject;
+	for (auto const &combination: bestSubjectsCombinations) {
+		for (auto const &[subject, startingWeek]: combination) {
+			if (subject.getFrequency() <= nbWeeks) {
+				possiblePhasesBySubject[subject].insert(std::ranges::find(weeks, startingWeek) - weeks.begin());
+			}
+		}
+	}
+
+	vector<bool> isTeacherWithoutColles(state->getTeachers().size(), false);
+	for (auto const &teacher: state->getTeachers() | std::views::filter(&Teacher::hasMeanWeeklyVolume)) {
+		auto const &totalVolume = teacher.getTotalVolume(nbWeeks);
+		isTeacherWithoutColles[teacher.getIndex()] = totalVolume.isExact && totalVolume.value == 0;
+	}
+
+	// The lunch constraint only applies to the modelled weeks
+	auto const &lunchTimeRange = state->getLunchTimeRange();
+	std::set<std::tuple<int, int, Timeslot>> onlyLunchTimeslots;
+	for (auto const &trio: state->getTrios()) {
+		for (int idWeek = 0; idWeek < nbModelledWeeks; ++idWeek) {
+			std::map<Day, vector<Timeslot>> lunchTimeslotsByDay;
+			for (auto const &timeslot: state->getAvailableTimeslots(trio, weeks[idWeek])) {
+				if (timeslot.getHour() >= lunchTimeRange.first && timeslot.getHour() < lunchTimeRange.second) {
+					lunchTimeslotsByDay[timeslot.getDay()].push_back(timeslot);
+				}
+			}
+
+			for (auto const &[day, lunchTimeslots]: lunchTimeslotsByDay) {
+				if (lunchTimeslots.size() == 1) {
+					onlyLunchTimeslots.emplace(trio.getId(), idWeek, lunchTimeslots.front());
+				}
+			}
+		}
+	}
+
+	return [possiblePhasesBySubject = std::move(possiblePhasesBySubject), isTeacherWithoutColles = std::move(isTeacherWithoutColles), onlyLunchTimeslots = std::move(onlyLunchTimeslots)](
+		Teacher const &teacher, Trio const &trio, int idWeek, Timeslot const &timeslot
+	) {
+		auto const &subject = teacher.getSubject();
+		auto const &possiblePhases = possiblePhasesBySubject.find(subject);
+		if (possiblePhases != possiblePhasesBySubject.end() && !possiblePhases->second.contains(idWeek % subject.getFrequency())) {
+			return true;
+		}
+
+		return isTeacherWithoutColles[teacher.getIndex()] || onlyLunchTimeslots.contains({trio.getId(), idWeek, timeslot});
+	};
+}
+
+bool Solver::isSubjectInWeek(unordered_map<Subject, Week> const &subjectsCombination, Subject const &subject, Week const &week)
+{
+	auto const &startingWeek = subjectsCombination.at(subject);
+	int distance = week.getId() - startingWeek.getId();
+	return distance >= 0 && distance % subject.getFrequency() == 0;
+}
+
+/** The number of subjects a trio has during the busiest week of the cycle, when following the given combination */
+int Solver::getMaxNbSubjectsInWeek(unordered_map<Subject, Week> const &subjectsCombination) const
+{
+	int maxNbSubjects = 0;
+	for (auto const &week: state->getWeeks() | std::views::take(getCycleDuration())) {
+		int nbSubjects = std::ranges::count_if(state->getSubjects(), [&](auto const &subject) {
+			return isSubjectInWeek(subjectsCombination, subject, week);
+		});
+
+		maxNbSubjects = std::max(maxNbSubjects, nbSubjects);
+	}
+
+	return maxNbSubjects;
+}
+
+vector<Colle> Solver::getColles(CpSolverResponse const &response, ColleVars const &colleVars) const
 {
+	auto const &solution = response.solution();
+	auto const &isColleInSolution = [&](auto const &colleVar) {
+		// A negative index refers to the negation of a variable
+		auto const varIndex = colleVar.first;
+		return varIndex >= 0 ? solution[varIndex] != 0 : solution[-varIndex - 1] == 0;
+	};
+
 	vector<Colle> colles;
+	colles.reserve(std::ranges::count_if(colleVars, isColleInSolution));
+	for (auto const &colleVar: colleVars) {
+		if (isColleInSolution(colleVar)) {
+			colles.push_back(colleVar.second);
+		}
+	}
+
+	return colles;
+}
+
+/**
+ * Run all the independent searches of the portfolio in parallel, and merge their solutions into a single stream of improving ones.
+ * The searches are stopped when requested, when one of them proves the optimality or the infeasibility,
+ * when they stall and the neighbourhood search can take over, or when a solution calls for a new search, as `shouldStopAfterSolution` tells.
+ */
+CpSolverResponse Solver::searchGlobally(
+	CpModelProto const &modelProto,
+	ColleVars const &colleVars,
+	LinearExpr const &globalObjectiveExpression,
+	CpSolverResponse const *initialResponse,
+	std::function<void(CpSolverResponse const &response)> const &solutionImproved,
+	std::function<bool()> const &shouldStopAfterSolution
+)
+{
+	auto const &parameters = state->getSolverParameters();
+	auto const &portfolio = parameters.getPortfolio();
+	int const nbWorkersByRun = std::max(1, QThread::idealThreadCount() / static_cast<int>(portfolio.size()));
+
+	std::atomic<bool> shouldGlobalSearchBeStopped = shouldComputationBeStopped.load();
+	std::mutex bestResponseMutex;
+	CpSolverResponse bestResponse;
+	std::optional<std::int64_t> bestObjectiveValue;
+	std::optional<std::chrono::steady_clock::time_point> lastPortfolioImprovement;
+	if (initialResponse != nullptr) {
+		bestResponse = *initialResponse;
+		bestObjectiveValue = initialResponse->objective_value();
+		lastPortfolioImprovement = std::chrono::steady_clock::now();
+	}
+
+	std::jthread globalSearchWatcher([&](std::stop_token stopToken) {
+		auto const stallDuration = std::chrono::duration<double>(parameters.getNeighbourhoodSearchStallDuration());
+		while (!stopToken.stop_requested()) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+			std::scoped_lock lock(bestResponseMutex);
+			bool const hasStalled = parameters.isNeighbourhoodSearchEnabled() && lastPortfolioImprovement.has_value() && std::chrono::steady_clock::now() - *lastPortfolioImprovement > stallDuration;
+			if (shouldComputationBeStopped || hasStalled) {
+				shouldGlobalSearchBeStopped = true;
+				return;
+			}
+		}
+	});
+
+	auto const &responses = QtConcurrent::blockingMapped<vector<CpSolverResponse>>(portfolio, [&](PortfolioRun const &run) {
+		// Starting CP-SAT when it should already be stopped is useless, and has been seen to fail
+		if (shouldGlobalSearchBeStopped) {
+			return CpSolverResponse();
+		}
+
+		SatParameters satParameters;
+		satParameters.set_random_seed(run.seed);
+		if (portfolio.size() > 1) {
+			satParameters.set_num_workers(nbWorkersByRun);
+		}
+
+		satParameters.set_log_search_progress(!run.isFeasibilityFirst);
+		satParameters.set_log_to_stdout(false);
+
+		SatParameters::SearchBranching searchBranching;
+		if (SatParameters::SearchBranching_Parse(run.searchBranching.toStdString(), &searchBranching)) {
+			satParameters.set_search_branching(searchBranching);
+		}
+
+		if (parameters.getMemoryBudget() > 0) {
+			satParameters.set_max_memory_in_mb(parameters.getMemoryBudget() / portfolio.size());
+		}
+
+		// A feasibility-first run ignores the objective, and only aims at finding a first solution as quickly as possible,
+		// and a run with a decision strategy follows it without any other heuristic.
+		// The other runs share the same proto, as copying it is expensive for large instances.
+		std::optional<CpModelProto> runModelProto;
+		if (run.isFeasibilityFirst || run.decisionStrategy != DecisionStrategy::Default) {
+			runModelProto = modelProto;
+		}
+
+		if (run.isFeasibilityFirst) {
+			runModelProto->clear_objective();
+		}
+
+		if (run.decisionStrategy != DecisionStrategy::Default) {
+			addDecisionStrategy(runModelProto.value(), colleVars, run.decisionStrategy);
+			if (run.searchBranching.isEmpty()) {
+				satParameters.set_search_branching(SatParameters::FIXED_SEARCH);
+			}
+		}
+
+		Model model;
+		model.Add(NewSatParameters(satParameters));
+		model.GetOrCreate<TimeLimit>()->RegisterExternalBooleanAsLimit(&shouldGlobalSearchBeStopped);
+		model.Add(NewFeasibleSolutionObserver([&] (auto const &response) {
+			auto const objectiveValue = SolutionIntegerValue(response, globalObjectiveExpression);
+
+			std::scoped_lock lock(bestResponseMutex);
+			if (bestObjectiveValue.has_value() && objectiveValue >= bestObjectiveValue.value()) {
+				return;
+			}
+
+			bestObjectiveValue = objectiveValue;
+			bestResponse = response;
+			bestResponse.set_objective_value(objectiveValue);
+			if (run.isFeasibilityFirst) {
+				bestResponse.clear_best_objective_bound();
+			}
+			lastPortfolioImprovement = std::chrono::steady_clock::now();
+			solutionImproved(bestResponse);
+			if (shouldStopAfterSolution && shouldStopAfterSolution()) {
+				shouldGlobalSearchBeStopped = true;
+			}
+		}));
+
+		// The bound only appears in the log between two solutions
+		if (!run.isFeasibilityFirst) {
+			model.GetOrCreate<SolverLogger>()->AddInfoLoggingCallback([&](std::string const &message) {
+				updateStatisticsFromLog(message);
+			});
+		}
+
+		auto response = runSearch(runModelProto.has_value() ? runModelProto.value() : modelProto, model);
+		if (run.isFeasibilityFirst && response.status() == CpSolverStatus::OPTIMAL) {
+			response.set_status(CpSolverStatus::FEASIBLE);
+		}
+
+		// A proof of optimality or of infeasibility settles the search, so the other runs have nothing left to find
+		if (response.status() == CpSolverStatus::OPTIMAL || response.status() == CpSolverStatus::INFEASIBLE) {
+			shouldGlobalSearchBeStopped = true;
+		}
+
+		return response;
+	});
+
+	globalSearchWatcher.request_stop();
+	globalSearchWatcher.join();
+
+	for (auto const &response: responses) {
+		qDebug().noquote() << QString::fromStdString(CpSolverResponseStats(response)).replace("\n", "\n\t");
+	}
+
+	if (std::ranges::any_of(responses, [](auto const &response) { return response.status() == CpSolverStatus::OPTIMAL; })) {
+		bestResponse.set_status(CpSolverStatus::OPTIMAL);
+	}
+	else if (std::ranges::any_of(responses, [](auto const &response) { return response.status() == CpSolverStatus::INFEASIBLE; })) {
+		bestResponse.set_status(CpSolverStatus::INFEASIBLE);
+	}
+	else {
+		bestResponse.set_status(bestObjectiveValue.has_value() ? CpSolverStatus::FEASIBLE : CpSolverStatus::UNKNOWN);
+	}
+
+	return bestResponse;
+}
+
+/**
+ * Decide the colles week by week, or trio by trio, each one being set before the next ones are considered.
+ * Within a week or a trio, the colles are ordered by teacher, then by timeslot, then by trio or week,
+ * so that each teacher fills the same timeslots first every time, which keeps the number of slots low.
+ */
+void Solver::addDecisionStrategy(CpModelProto &modelProto, ColleVars const &colleVars, DecisionStrategy decisionStrategy) const
+{
+	bool const isByTrio = decisionStrategy == DecisionStrategy::ByTrio;
+	auto orderedColleVars = colleVars;
+	std::ranges::sort(orderedColleVars, {}, [&](auto const &colleVar) {
+		auto const &colle = colleVar.second;
+		int const idWeek = colle.getWeek().getId();
+		int const idTrio = colle.getTrio().getId();
+		return std::tuple(isByTrio ? idTrio : idWeek, colle.getTeacher().getIndex(), colle.getTimeslot(), isByTrio ? idWeek : idTrio);
+	});
+
+	auto *strategy = modelProto.add_search_strategy();
+	strategy->set_variable_selection_strategy(DecisionStrategyProto::CHOOSE_FIRST);
+	strategy->set_domain_reduction_strategy(DecisionStrategyProto::SELECT_MAX_VALUE);
+
+	// In periodic mode, a variable is shared by several colles, and is only decided once
+	std::unordered_set<int> addedVarIndexes;
+	for (auto const &[varIndex, colle]: orderedColleVars) {
+		if (addedVarIndexes.insert(varIndex).second) {
+			strategy->add_variables(varIndex);
+		}
+	}
+}
+
+ColleVars Solver::getColleVars(SolverVar const &isTrioWithTeacherAtTimeslotInWeek) const
+{
+	ColleVars colleVars;
 	for (auto const &week: state->getWeeks()) {
 		for (auto const &teacher: state->getTeachers()) {
 			for (auto const &trio: state->getTrios()) {
 				for (auto const &timeslot: state->getAvailableTimeslots(teacher, trio, week)) {
-					if (SolutionBooleanValue(response, isTrioWithTeacherAtTimeslotInWeek.at(trio).at(teacher).at(timeslot).at(week))) {
-						colles.push_back(Colle(teacher, timeslot, trio, week));
+					// The pruned colles, whose variable is the negation of the constant true one, are never part of a solution
+					auto const &var = isTrioWithTeacherAtTimeslotInWeek.at(trio).at(teacher).at(timeslot).at(week);
+					if (var.index() < 0) {
+						continue;
 					}
+
+					colleVars.emplace_back(var.index(), Colle(teacher, timeslot, trio, week));
 				}
 			}
 		}
 	}
 
-	return colles;
+	return colleVars;
+}
+
+/**
+ * Improve the given solution by repeatedly fixing most of the colles, and solving the sub-models where only a neighbourhood is left open.
+ * Several neighbourhoods are explored in parallel, each with a short time limit, and the best improvement is kept,
+ * until a given number of consecutive rounds bring no improvement.
+ */
+void Solver::searchNeighbourhoods(
+	CpModelProto const &modelProto,
+	ColleVars const &colleVars,
+	CpSolverResponse const &initialResponse,
+	std::function<void(CpSolverResponse const &response)> const &solutionImproved
+)
+{
+	auto const &parameters = state->getSolverParameters();
+	int const nbThreads = std::max(1, QThread::idealThreadCount());
+	std::mt19937 randomGenerator(0);
+
+	auto bestResponse = initialResponse;
+	int nbRoundsWithoutImprovement = 0;
+	for (int idRound = 0; !shouldComputationBeStopped && nbRoundsWithoutImprovement < parameters.getNeighbourhoodSearchMaxRoundsWithoutImprovement(); ++idRound) {
+		vector<CpModelProto> neighbourhoodModels;
+		for (int idThread = 0; idThread < nbThreads; ++idThread) {
+			auto const &isInNeighbourhood = getRandomNeighbourhood(idRound * nbThreads + idThread, randomGenerator);
+			neighbourhoodModels.push_back(getNeighbourhoodModel(modelProto, colleVars, bestResponse, isInNeighbourhood));
+		}
+
+		auto const &responses = QtConcurrent::blockingMapped<vector<CpSolverResponse>>(neighbourhoodModels, [&](CpModelProto const &neighbourhoodModel) {
+			if (shouldComputationBeStopped) {
+				return CpSolverResponse();
+			}
+
+			SatParameters satParameters;
+			satParameters.set_num_workers(1);
+			satParameters.set_max_time_in_seconds(parameters.getNeighbourhoodSearchTimeLimit());
+
+			Model model;
+			model.Add(NewSatParameters(satParameters));
+			model.GetOrCreate<TimeLimit>()->RegisterExternalBooleanAsLimit(&shouldComputationBeStopped);
+			return runSearch(neighbourhoodModel, model);
+		});
+
+		bool hasImproved = false;
+		for (auto const &response: responses) {
+			bool const hasSolution = response.status() == CpSolverStatus::FEASIBLE || response.status() == CpSolverStatus::OPTIMAL;
+			if (hasSolution && response.objective_value() < bestResponse.objective_value()) {
+				// The bound of a sub-model is not a bound of the whole model
+				bestResponse = response;
+				bestResponse.clear_best_objective_bound();
+				hasImproved = true;
+			}
+		}
+
+		if (hasImproved) {
+			qDebug() << "Neighbourhood search improved the objective to" << bestResponse.objective_value();
+			solutionImproved(bestResponse);
+			nbRoundsWithoutImprovement = 0;
+		}
+		else {
+			++nbRoundsWithoutImprovement;
+		}
+	}
+}
+
+/** The neighbourhoods are, in turn, the colles of one teacher, of one trio, of one week or of one day */
+std::function<bool(Colle const &colle)> Solver::getRandomNeighbourhood(int idNeighbourhood, std::mt19937 &randomGenerator) const
+{
+	auto const &getRandomElement = [&](auto const &elements) -> auto const & {
+		std::uniform_int_distribution<std::size_t> distribution(0, elements.size() - 1);
+		return elements[distribution(randomGenerator)];
+	};
+
+	switch (idNeighbourhood % 4) {
+		case 0: {
+			auto const *teacher = &getRandomElement(state->getTeachers());
+			return [=](Colle const &colle) { return &colle.getTeacher() == teacher; };
+		}
+
+		case 1: {
+			auto const *trio = &getRandomElement(state->getTrios());
+			return [=](Colle const &colle) { return &colle.getTrio() == trio; };
+		}
+
+		case 2: {
+			auto const *week = &getRandomElement(state->getWeeks());
+			return [=](Colle const &colle) { return &colle.getWeek() == week; };
+		}
+
+		default: {
+			auto const day = getRandomElement(Timeslot::days);
+			return [=](Colle const &colle) { return colle.getTimeslot().getDay() == day; };
+		}
+	}
+}
+
+CpModelProto Solver::getNeighbourhoodModel(
+	CpModelProto const &modelProto,
+	ColleVars const &colleVars,
+	CpSolverResponse const &response,
+	std::function<bool(Colle const &colle)> const &isInNeighbourhood
+) const
+{
+	auto neighbourhoodModel = modelProto;
+	fixOutsideOfNeighbourhood(neighbourhoodModel, colleVars, isInNeighbourhood, [&](int varIndex) { return response.solution(varIndex); });
+
+	auto *solutionHint = neighbourhoodModel.mutable_solution_hint();
+	solutionHint->Clear();
+	for (int varIndex = 0; varIndex < response.solution_size(); ++varIndex) {
+		solutionHint->add_vars(varIndex);
+		solutionHint->add_values(response.solution(varIndex));
+	}
+
+	return neighbourhoodModel;
+}
+
+void Solver::fixOutsideOfNeighbourhood(
+	CpModelProto &modelProto,
+	ColleVars const &colleVars,
+	std::function<bool(Colle const &colle)> const &isInNeighbourhood,
+	std::function<std::int64_t(int varIndex)> const &getValue
+) const
+{
+	// In periodic mode, a variable is shared by several colles, and is left open if any of them is in the neighbourhood
+	std::unordered_set<int> openVarIndexes;
+	for (auto const &[varIndex, colle]: colleVars) {
+		if (isInNeighbourhood(colle)) {
+			openVarIndexes.insert(varIndex);
+		}
+	}
+
+	for (auto const &[varIndex, colle]: colleVars) {
+		if (!openVarIndexes.contains(varIndex)) {
+			auto const value = getValue(varIndex);
+			auto *var = modelProto.mutable_variables(varIndex);
+			var->clear_domain();
+			var->add_domain(value);
+			var->add_domain(value);
+		}
+	}
+}
+
+/**
+ * Solve the model with the colles of the unchanged entities fixed to their value in the previous solution.
+ * The teachers of the same subject as a changed teacher are reopened too, as the colles can be moved between them.
+ */
+CpSolverResponse Solver::repairPreviousSolution(CpModelProto const &modelProto, ColleVars const &colleVars, unordered_map<int, bool> const &previousValues)
+{
+	throwIfComputationStopped(shouldComputationBeStopped);
+	auto const &changes = state->getChanges();
+
+	std::unordered_set<Subject const *> changedSubjects;
+	for (auto const &teacher: state->getTeachers()) {
+		if (changes.teacherIds.contains(teacher.getId())) {
+			changedSubjects.insert(&teacher.getSubject());
+		}
+	}
+
+	std::unordered_set<Trio const *> changedTrios;
+	for (auto const &trio: state->getTrios()) {
+		if (changes.trioIds.contains(trio.getId()) || trio.dependsOnGroups(changes.groupIds)) {
+			changedTrios.insert(&trio);
+		}
+	}
+
+	auto repairModel = modelProto;
+	fixOutsideOfNeighbourhood(
+		repairModel,
+		colleVars,
+		[&](Colle const &colle) {
+			return changedSubjects.contains(&colle.getSubject())
+				|| changedTrios.contains(&colle.getTrio())
+				|| changes.weekIds.contains(colle.getWeek().getId())
+			;
+		},
+		[&](int varIndex) { return previousValues.at(varIndex); }
+	);
+
+	SatParameters satParameters;
+	satParameters.set_max_time_in_seconds(state->getSolverParameters().getNeighbourhoodSearchTimeLimit());
+
+	Model model;
+	model.Add(NewSatParameters(satParameters));
+	model.GetOrCreate<TimeLimit>()->RegisterExternalBooleanAsLimit(&shouldComputationBeStopped);
+	auto response = runSearch(repairModel, model);
+
+	// The bound of the restricted model is not a bound of the whole model
+	response.clear_best_objective_bound();
+	return response;
+}
+
+/** Solve the model with the colles of the greedy solution fixed, so that the missing colles, the objectives and the other variables are computed */
+CpSolverResponse Solver::completeGreedySolution(CpModelProto const &modelProto, unordered_map<int, bool> const &greedyValues)
+{
+	throwIfComputationStopped(shouldComputationBeStopped);
+
+	// Only the greedy colles are fixed, so that CP-SAT adds around them the colles the heuristic left out,
+	// including the ones the teachers under their volume still need.
+	auto greedyModel = modelProto;
+	for (auto const &[varIndex, value]: greedyValues) {
+		if (value) {
+			auto *var = greedyModel.mutable_variables(varIndex);
+			var->clear_domain();
+			var->add_domain(1);
+			var->add_domain(1);
+		}
+	}
+
+	SatParameters satParameters;
+	satParameters.set_max_time_in_seconds(state->getSolverParameters().getNeighbourhoodSearchTimeLimit());
+
+	Model model;
+	model.Add(NewSatParameters(satParameters));
+	model.GetOrCreate<TimeLimit>()->RegisterExternalBooleanAsLimit(&shouldComputationBeStopped);
+	auto response = runSearch(greedyModel, model);
+
+	// The bound of the fixed model is not a bound of the whole model
+	response.clear_best_objective_bound();
+	return response;
+}
+
+/** In periodic mode, a variable is shared by several colles, and is true if any of them is part of the given ones */
+unordered_map<int, bool> Solver::getVarValues(ColleVars const &colleVars, std::set<ColleIds> const &colleIds)
+{
+	unordered_map<int, bool> values;
+	for (auto const &[varIndex, colle]: colleVars) {
+		values[varIndex] = values[varIndex] || colleIds.contains(getColleIds(colle));
+	}
+
+	return values;
+}
+
+ColleIds Solver::getColleIds(Colle const &colle)
+{
+	return {colle.getTeacher().getId(), colle.getTrio().getId(), colle.getWeek().getId(), colle.getTimeslot()};
 }
@@ -1,41 +1,142 @@
 #pragma once
 
+#include <QString>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <mutex>
+#include <random>
+#include <set>
+#include <stop_token>
+#include <string>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
+#include "SearchStatistics.h"
+#include "Timeslot.h"
 
 namespace operations_research::sat {
 	class BoolVar;
+	class CpModelBuilder;
+	class CpModelProto;
 	class CpSolverResponse;
+	class LinearExpr;
+	class Model;
 }
+class QJsonArray;
 class Colle;
+enum class DecisionStrategy;
 class Objective;
 class ObjectiveComputation;
 class State;
 class Subject;
 class Teacher;
-class Timeslot;
 class Trio;
 class Week;
 
 using SolverVar = std::unordered_map<Trio, std::unordered_map<Teacher, std::unordered_map<Timeslot, std::unordered_map<Week, operations_research::sat::BoolVar>>>>;
+using ColleVars = std::vector<std::pair<int, Colle>>;
+
+/** The ids of the teacher, the trio and the week of a colle, along with its timeslot, which stay valid after a new import */
+using ColleIds = std::tuple<QString, int, int, Timeslot>;
+
+using SolutionFoundCallback = std::function<void(std::vector<Colle> const &colles, std::vector<ObjectiveComputation> const &objectiveComputations, SearchStatistics const &statistics)>;
 
 class Solver
 {
 	public:
 		Solver(State const &state);
 		Solver(State const &&state) = delete;
-		bool compute(std::function<void(std::vector<Colle> const &colles, std::vector<ObjectiveComputation> const &objectiveComputations)> const &solutionFound);
+		bool compute(SolutionFoundCallback const &solutionFound);
+		void prepareComputation();
 		void stopComputation();
+		void setPreviousColles(QJsonArray const &jsonColles);
+		SearchStatistics getStatistics() const;
 
 	protected:
 		State const *state;
 		std::atomic<bool> shouldComputationBeStopped;
+		std::set<ColleIds> previousColles;
+
+		std::chrono::steady_clock::time_point computationStart;
+		std::chrono::steady_clock::time_point lastImprovement;
+		mutable std::mutex statisticsMutex;
+		SearchStatistics statistics;
+
+		/** In megabytes, at the end of the previous phase */
+		double lastHeapSize = 0;
+
+		bool buildAndSearch(SolutionFoundCallback const &solutionFound);
+		bool searchLocally(SolutionFoundCallback const &solutionFound);
+		SearchStatistics recordImprovement(double objectiveValue, double bestBound);
+		void addRedundantConstraints(
+			operations_research::sat::CpModelBuilder &modelBuilder,
+			SolverVar const &isTrioWithTeacherAtTimeslotInWeek,
+			std::vector<std::unordered_map<Subject, Week>> const &bestSubjectsCombinations
+		) const;
+		void watchConvergence(std::stop_token stopToken);
+		void setPhase(QString const &phase);
+		void updateStatisticsFromLog(std::string const &message);
+		operations_research::sat::CpSolverResponse runSearch(operations_research::sat::CpModelProto const &modelProto, operations_research::sat::Model &model);
 
+		bool isPeriodic() const;
 		int getCycleDuration() const;
+		int getPeriodicCycleDuration() const;
 		std::vector<std::unordered_map<Subject, Week>> getBestSubjectsCombinations() const;
+		int getMaxNbSubjectsInWeek(std::unordered_map<Subject, Week> const &subjectsCombination) const;
+		static bool isSubjectInWeek(std::unordered_map<Subject, Week> const &subjectsCombination, Subject const &subject, Week const &week);
+		std::function<bool(Teacher const &teacher, Trio const &trio, int idWeek, Timeslot const &timeslot)> getImpossibleColleFilter(
+			std::vector<std::unordered_map<Subject, Week>> const &bestSubjectsCombinations,
+			int nbModelledWeeks
+		) const;
+
+		std::vector<Colle> getColles(operations_research::sat::CpSolverResponse const &response, ColleVars const &colleVars) const;
+		ColleVars getColleVars(SolverVar const &isTrioWithTeacherAtTimeslotInWeek) const;
+		void addDecisionStrategy(operations_research::sat::CpModelProto &modelProto, ColleVars const &colleVars, DecisionStrategy decisionStrategy) const;
+
+		operations_research::sat::CpSolverResponse searchGlobally(
+			operations_research::sat::CpModelProto const &modelProto,
+			ColleVars const &colleVars,
+			operations_research::sat::LinearExpr const &globalObjectiveExpression,
+			operations_research::sat::CpSolverResponse const *initialResponse,
+			std::function<void(operations_research::sat::CpSolverResponse const &response)> const &solutionImproved,
+			std::function<bool()> const &shouldStopAfterSolution = nullptr
+		);
+
+		void searchNeighbourhoods(
+			operations_research::sat::CpModelProto const &modelProto,
+			ColleVars const &colleVars,
+			operations_research::sat::CpSolverResponse const &initialResponse,
+			std::function<void(operations_research::sat::CpSolverResponse const &response)> const &solutionImproved
+		);
+		std::function<bool(Colle const &colle)> getRandomNeighbourhood(int idNeighbourhood, std::mt19937 &randomGenerator) const;
+		operations_research::sat::CpModelProto getNeighbourhoodModel(
+			operations_research::sat::CpModelProto const &modelProto,
+			ColleVars const &colleVars,
+			operations_research::sat::CpSolverResponse const &response,
+			std::function<bool(Colle const &colle)> const &isInNeighbourhood
+		) const;
+		void fixOutsideOfNeighbourhood(
+			operations_research::sat::CpModelProto &modelProto,
+			ColleVars const &colleVars,
+			std::function<bool(Colle const &colle)> const &isInNeighbourhood,
+			std::function<std::int64_t(int varIndex)> const &getValue
+		) const;
+		operations_research::sat::CpSolverResponse repairPreviousSolution(
+			operations_research::sat::CpModelProto const &modelProto,
+			ColleVars const &colleVars,
+			std::unordered_map<int, bool> const &previousValues
+		);
+
+		operations_research::sat::CpSolverResponse completeGreedySolution(
+			operations_research::sat::CpModelProto const &modelProto,
+			std::unordered_map<int, bool> const &greedyValues
+		);
 
-		std::vector<Colle> getColles(operations_research::sat::CpSolverResponse const &response, SolverVar const &isTrioWithTeacherAtTimeslotInWeek) const;
+		static ColleIds getColleIds(Colle const &colle);
+		static std::unordered_map<int, bool> getVarValues(ColleVars const &colleVars, std::set<ColleIds> const &colleIds);
+		void logMemoryUsage(QString const &phase);
 };
 
@@ -0,0 +1,176 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Objective/MinimalNumberOfSlotsObjective.h"
+#include "Objective/ObjectiveComputation.h"
+#include "Objective/ObjectiveRegistry.h"
+#include "Objective/OnlyOneCollePerDayObjective.h"
+#include "JsonStates.test.h"
+#include "Solver.h"
+#include "State.h"
+
+namespace {
+	/** The lower bound is added to the model, so it has to be left out to check that it does not exclude the optimum */
+	template <typename ConcreteObjective>
+	class ObjectiveWithoutLowerBound : public ConcreteObjective
+	{
+		public:
+			int getLowerBound(State const *) const override
+			{
+				return 0;
+			}
+	};
+
+	/** The optimal value of the objective alone, along with the lower bound it gives */
+	template <typename ConcreteObjective>
+	std::pair<int, int> getOptimalValueAndLowerBound(QJsonObject const &jsonState)
+	{
+		ObjectiveRegistry objectiveRegistry;
+		objectiveRegistry.add<ObjectiveWithoutLowerBound<ConcreteObjective>>();
+		State state(objectiveRegistry);
+		state.import(jsonState);
+		Solver solver(state);
+
+		int optimalValue = -1;
+		REQUIRE(solver.compute([&](auto const &, auto const &objectiveComputations, auto const &) {
+			optimalValue = objectiveComputations.front().getValue();
+		}));
+
+		return {optimalValue, ConcreteObjective().getLowerBound(&state)};
+	}
+}
+
+TEST_CASE("stopComputation") {
+	State state;
+	state.import(getLargeJsonState(6, 10));
+	Solver solver(state);
+	solver.prepareComputation();
+
+	SECTION("during the computation") {
+		// Stopping right away interrupts the model building, while stopping later interrupts the search
+		auto const delayBeforeStop = GENERATE(std::chrono::milliseconds(20), std::chrono::milliseconds(500));
+
+		std::thread computation([&]() {
+			solver.compute([](auto const &, auto const &, auto const &) {});
+		});
+
+		std::this_thread::sleep_for(delayBeforeStop);
+		auto const stopTime = std::chrono::steady_clock::now();
+		solver.stopComputation();
+		computation.join();
+
+		REQUIRE(std::chrono::steady_clock::now() - stopTime < std::chrono::seconds(1));
+	}
+
+	SECTION("before the computation starts") {
+		solver.stopComputation();
+
+		bool hasFoundSolution = false;
+		REQUIRE_FALSE(solver.compute([&](auto const &, auto const &, auto const &) { hasFoundSolution = true; }));
+		REQUIRE_FALSE(hasFoundSolution);
+
+		// The stop only applies to a single computation, the next one being stopped at its first solution
+		solver.prepareComputation();
+		REQUIRE(solver.compute([&](auto const &, auto const &, auto const &) { solver.stopComputation(); }));
+	}
+}
+
+TEST_CASE("Periodic mode") {
+	// Each of the two teachers can only have colles every other week, so the cycle lasts two weeks even though the subject is weekly
+	auto const &jsonTimeslots = QJsonArray({QJsonObject({{"day", 0}, {"hour", 10}})});
+	auto const &getJsonTeacher = [&](QString const &id) {
+		return QJsonObject({
+			{"id", id},
+			{"name", id},
+			{"subjectId", "maths"},
+			{"availableTimeslots", jsonTimeslots},
+			{"weeklyAvailabilityFrequency", 2},
+			{"meanWeeklyVolume", 0.5},
+		});
+	};
+
+	// Without whole cycles, the model of the whole year is used instead
+	int const nbWeeks = GENERATE(4, 5);
+	QJsonArray jsonWeeks;
+	for (int idWeek = 0; idWeek < nbWeeks; ++idWeek) {
+		jsonWeeks << QJsonObject({{"id", idWeek}, {"number", idWeek + 1}});
+	}
+
+	State state;
+	state.import({
+		{"groups", QJsonArray({QJsonObject({{"id", "group"}, {"name", "group"}, {"availableTimeslots", jsonTimeslots}})})},
+		{"subjects", QJsonArray({QJsonObject({{"id", "maths"}, {"name", "Maths"}, {"shortName", "M"}, {"frequency", 1}})})},
+		{"teachers", QJsonArray({getJsonTeacher("a"), getJsonTeacher("b")})},
+		{"trios", QJsonArray({QJsonObject({{"id", 0}, {"initialGroupIds", QJsonArray({"group"})}})})},
+		{"weeks", jsonWeeks},
+		{"objectives", QJsonArray()},
+		{"lunchTimeRange", QJsonArray({12, 14})},
+		{"forbiddenSubjectIdsCombination", QJsonArray()},
+		{"solverParameters", QJsonObject({{"periodicMode", true}, {"progressInterval", 0}})},
+	});
+	Solver solver(state);
+
+	std::size_t nbColles = 0;
+	REQUIRE(solver.compute([&](auto const &colles, auto const &, auto const &) { nbColles = colles.size(); }));
+	REQUIRE(nbColles == static_cast<std::size_t>(nbWeeks));
+}
+
+TEST_CASE("Lower bounds of the objectives") {
+	// Both subjects every week, and only on Monday, so that the trios cannot avoid having two colles on the same day
+	auto jsonState = getSmallJsonState();
+	auto const &mondayTimeslots = QJsonArray({QJsonObject({{"day", 0}, {"hour", 10}}), QJsonObject({{"day", 0}, {"hour", 11}})});
+	auto const &setInEach = [&](QString const &entities, QString const &key, QJsonValue const &value) {
+		QJsonArray jsonEntities;
+		for (auto const &jsonEntity: jsonState[entities].toArray()) {
+			auto jsonEntityObject = jsonEntity.toObject();
+			jsonEntityObject[key] = value;
+			jsonEntities << jsonEntityObject;
+		}
+		jsonState[entities] = jsonEntities;
+	};
+	setInEach("subjects", "frequency", 1);
+	setInEach("groups", "availableTimeslots", mondayTimeslots);
+	setInEach("teachers", "availableTimeslots", mondayTimeslots);
+	jsonState["solverParameters"] = QJsonObject({{"progressInterval", 0}});
+
+	SECTION("Minimal number of slots") {
+		auto const &[optimalValue, lowerBound] = getOptimalValueAndLowerBound<MinimalNumberOfSlotsObjective>(jsonState);
+		REQUIRE(lowerBound > 0);
+		REQUIRE(lowerBound <= optimalValue);
+	}
+
+	SECTION("Only one colle per day") {
+		auto const &[optimalValue, lowerBound] = getOptimalValueAndLowerBound<OnlyOneCollePerDayObjective>(jsonState);
+		REQUIRE(lowerBound > 0);
+		REQUIRE(lowerBound <= optimalValue);
+	}
+}
+
+TEST_CASE("Lazy same slot intervals") {
+	// The intervals added once a solution breaks them lead to the same optimum as the ones all in the model from the start
+	auto const &getOptimalValues = [](bool areSameSlotIntervalsLazy) {
+		auto jsonState = getSmallJsonState();
+		jsonState["solverParameters"] = QJsonObject({{"lazySameSlotIntervals", areSameSlotIntervalsLazy}, {"progressInterval", 0}});
+		State state;
+		state.import(jsonState);
+		Solver solver(state);
+
+		std::vector<int> optimalValues;
+		REQUIRE(solver.compute([&](auto const &, auto const &objectiveComputations, auto const &) {
+			optimalValues.clear();
+			for (auto const &objectiveComputation: objectiveComputations) {
+				optimalValues.push_back(objectiveComputation.getValue());
+			}
+		}));
+
+		return optimalValues;
+	};
+
+	REQUIRE(getOptimalValues(true) == getOptimalValues(false));
+}
@@ -0,0 +1,140 @@
+#include "SolverParameters.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+
+SolverParameters::SolverParameters():
+	periodicMode(false),
+	neighbourhoodSearchStallDuration(0),
+	neighbourhoodSearchTimeLimit(5),
+	neighbourhoodSearchMaxRoundsWithoutImprovement(20),
+	portfolio{PortfolioRun{1, "", false, DecisionStrategy::Default}},
+	memoryBudget(0),
+	relativeGapLimit(0),
+	stallTimeLimit(0),
+	progressInterval(1),
+	objectiveMode(ObjectiveMode::Lexicographic),
+	redundantConstraints(true),
+	greedyHeuristic(true),
+	engine(Engine::CpSat),
+	lazySameSlotIntervals(false)
+{
+}
+
+SolverParameters::SolverParameters(QJsonObject const &json):
+	periodicMode(json["periodicMode"].toBool(false)),
+	neighbourhoodSearchStallDuration(json["neighbourhoodSearchStallDuration"].toDouble(0)),
+	neighbourhoodSearchTimeLimit(json["neighbourhoodSearchTimeLimit"].toDouble(5)),
+	neighbourhoodSearchMaxRoundsWithoutImprovement(json["neighbourhoodSearchMaxRoundsWithoutImprovement"].toInt(20)),
+	memoryBudget(json["memoryBudget"].toDouble(0)),
+	relativeGapLimit(json["relativeGapLimit"].toDouble(0)),
+	stallTimeLimit(json["stallTimeLimit"].toDouble(0)),
+	progressInterval(json["progressInterval"].toDouble(1)),
+	objectiveMode(json["objectiveMode"].toString() == "weightedSum" ? ObjectiveMode::WeightedSum : ObjectiveMode::Lexicographic),
+	redundantConstraints(json["redundantConstraints"].toBool(true)),
+	greedyHeuristic(json["greedyHeuristic"].toBool(true)),
+	engine(json["engine"].toString() == "localSearch" ? Engine::LocalSearch : Engine::CpSat),
+	lazySameSlotIntervals(json["lazySameSlotIntervals"].toBool(false))
+{
+	for (auto const &jsonRun: json["portfolio"].toArray()) {
+		auto const &jsonRunObject = jsonRun.toObject();
+		portfolio.push_back({
+			jsonRunObject["seed"].toInt(1),
+			jsonRunObject["searchBranching"].toString(),
+			jsonRunObject["feasibilityFirst"].toBool(false),
+			getDecisionStrategy(jsonRunObject["decisionStrategy"].toString()),
+		});
+	}
+
+	if (portfolio.empty()) {
+		portfolio.push_back({1, "", false, DecisionStrategy::Default});
+	}
+}
+
+bool SolverParameters::isPeriodicModeEnabled() const
+{
+	return periodicMode;
+}
+
+bool SolverParameters::isNeighbourhoodSearchEnabled() const
+{
+	return neighbourhoodSearchStallDuration > 0;
+}
+
+double SolverParameters::getNeighbourhoodSearchStallDuration() const
+{
+	return neighbourhoodSearchStallDuration;
+}
+
+double SolverParameters::getNeighbourhoodSearchTimeLimit() const
+{
+	return neighbourhoodSearchTimeLimit;
+}
+
+int SolverParameters::getNeighbourhoodSearchMaxRoundsWithoutImprovement() const
+{
+	return neighbourhoodSearchMaxRoundsWithoutImprovement;
+}
+
+std::vector<PortfolioRun> const &SolverParameters::getPortfolio() const
+{
+	return portfolio;
+}
+
+double SolverParameters::getMemoryBudget() const
+{
+	return memoryBudget;
+}
+
+double SolverParameters::getRelativeGapLimit() const
+{
+	return relativeGapLimit;
+}
+
+double SolverParameters::getStallTimeLimit() const
+{
+	return stallTimeLimit;
+}
+
+double SolverParameters::getProgressInterval() const
+{
+	return progressInterval;
+}
+
+ObjectiveMode SolverParameters::getObjectiveMode() const
+{
+	return objectiveMode;
+}
+
+bool SolverParameters::areRedundantConstraintsEnabled() const
+{
+	return redundantConstraints;
+}
+
+bool SolverParameters::isGreedyHeuristicEnabled() const
+{
+	return greedyHeuristic;
+}
+
+Engine SolverParameters::getEngine() const
+{
+	return engine;
+}
+
+bool SolverParameters::areSameSlotIntervalsLazy() const
+{
+	return lazySameSlotIntervals;
+}
+
+DecisionStrategy SolverParameters::getDecisionStrategy(QString const &name)
+{
+	if (name == "byWeek") {
+		return DecisionStrategy::ByWeek;
+	}
+
+	if (name == "byTrio") {
+		return DecisionStrategy::ByTrio;
+	}
+
+	return DecisionStrategy::Default;
+}
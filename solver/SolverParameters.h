@@ -0,0 +1,119 @@
+#pragma once
+
+#include <QString>
+#include <vector>
+
+class QJsonObject;
+
+/** How the objectives are combined into the global one */
+enum class ObjectiveMode {
+	/** An objective is only improved if the more important ones cannot be */
+	Lexicographic,
+
+	/** The objectives are summed, multiplied by their weights */
+	WeightedSum,
+};
+
+/** What searches for the colloscope */
+enum class Engine {
+	/** A model solved by CP-SAT, which can prove the optimality */
+	CpSat,
+
+	/** A simulated annealing over the colles, without any model, for the instances too large for CP-SAT */
+	LocalSearch,
+};
+
+/** The order in which a search decides the colles, instead of the one chosen by CP-SAT */
+enum class DecisionStrategy {
+	Default,
+
+	/** All the colles of the first week, then all the ones of the second week, and so on */
+	ByWeek,
+
+	/** All the colles of the first trio, then all the ones of the second trio, and so on */
+	ByTrio,
+};
+
+/** An independent search of the portfolio, run in parallel with the other ones */
+struct PortfolioRun {
+	int seed;
+
+	/** Name of one of the `SatParameters::SearchBranching` values of OR-Tools, or empty for the default one */
+	QString searchBranching;
+
+	bool isFeasibilityFirst;
+
+	/** Given as "byWeek" or "byTrio", the default one being used otherwise */
+	DecisionStrategy decisionStrategy;
+};
+
+class SolverParameters
+{
+	public:
+		SolverParameters();
+		explicit SolverParameters(QJsonObject const &json);
+
+		bool isPeriodicModeEnabled() const;
+		bool isNeighbourhoodSearchEnabled() const;
+		double getNeighbourhoodSearchStallDuration() const;
+		double getNeighbourhoodSearchTimeLimit() const;
+		int getNeighbourhoodSearchMaxRoundsWithoutImprovement() const;
+		std::vector<PortfolioRun> const &getPortfolio() const;
+		double getMemoryBudget() const;
+		double getRelativeGapLimit() const;
+		double getStallTimeLimit() const;
+		double getProgressInterval() const;
+		ObjectiveMode getObjectiveMode() const;
+		bool areRedundantConstraintsEnabled() const;
+		bool isGreedyHeuristicEnabled() const;
+		Engine getEngine() const;
+		bool areSameSlotIntervalsLazy() const;
+
+	protected:
+		static DecisionStrategy getDecisionStrategy(QString const &name);
+
+		/** Only model the first cycle of weeks, and repeat it for the following ones */
+		bool periodicMode;
+
+		/**
+		 * Duration in seconds without improvement before switching from the global search to the neighbourhood search, or 0 to disable it, as by default.
+		 * Only the global search can prove the optimality, so it is not resumed once stopped.
+		 */
+		double neighbourhoodSearchStallDuration;
+
+		/** Time limit in seconds of each sub-model of the neighbourhood search */
+		double neighbourhoodSearchTimeLimit;
+
+		/** Number of consecutive rounds of sub-models without improvement after which the neighbourhood search ends */
+		int neighbourhoodSearchMaxRoundsWithoutImprovement;
+
+		/** Never empty, a single run with the default parameters being used if none is given */
+		std::vector<PortfolioRun> portfolio;
+
+		/** Memory in megabytes above which the model building is stopped, and shared between the portfolio runs as their memory limit, or 0 for none */
+		double memoryBudget;
+
+		/** Relative gap between the best solution and the best bound under which the computation stops, or 0 to only stop once the solution is proven optimal */
+		double relativeGapLimit;
+
+		/** Duration in seconds without improvement after which the computation stops, or 0 to never stop because of it */
+		double stallTimeLimit;
+
+		/** Duration in seconds between two progress reports, or 0 to disable them */
+		double progressInterval;
+
+		/** Given as "lexicographic" or "weightedSum" */
+		ObjectiveMode objectiveMode;
+
+		/** Add the constraints implied by the other ones, which make the model larger but help CP-SAT to prune the search earlier */
+		bool redundantConstraints;
+
+		/** Build a first solution greedily before the search, when there is no previous one to start from */
+		bool greedyHeuristic;
+
+		/** Given as "cpSat" or "localSearch" */
+		Engine engine;
+
+		/** Only add the intervals of the "same slot only once in cycle" objective once a solution breaks them, and search again */
+		bool lazySameSlotIntervals;
+};
@@ -3,64 +3,462 @@
 #include <QJsonArray>
 #include <QJsonObject>
 #include <algorithm>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <unordered_map>
+#include "CborReader.h"
 #include "Objective/Objective.h"
 
-State::State(std::vector<Objective const *> const &objectives): objectives(objectives)
+State::State(ObjectiveRegistry const &objectiveRegistry): objectiveRegistry(objectiveRegistry)
 {
+	importObjectives({});
 }
 
-void State::import(QJsonObject const &json)
+State::~State() = default;
+
+template <typename Entity>
+std::unordered_map<QString, Entity const *> getEntitiesById(std::vector<Entity> const &entities)
+{
+	std::unordered_map<QString, Entity const *> entitiesById;
+	entitiesById.reserve(entities.size());
+	for (auto const &entity: entities) {
+		entitiesById[entity.getId()] = &entity;
+	}
+
+	return entitiesById;
+}
+
+/** @return Whether the state was valid; if not, the state is left unchanged */
+bool State::import(QJsonObject const &json)
 {
+	if (!validate(json)) {
+		return false;
+	}
+
+	changes = computeChanges(json);
+	previousJson = json;
+
 	groups.clear();
 	auto const &jsonGroups = json["groups"].toArray();
+	groups.reserve(jsonGroups.size());
 	for (auto const &jsonGroup: jsonGroups) {
-		groups.push_back(Group(jsonGroup.toObject()));
+		groups.push_back(Group(groups.size(), jsonGroup.toObject()));
 	}
+	auto const &groupsById = getEntitiesById(groups);
 	for (int idGroup = 0; idGroup < groups.size(); ++idGroup) {
-		groups[idGroup].setNextGroup(jsonGroups[idGroup].toObject(), groups);
+		groups[idGroup].setNextGroup(jsonGroups[idGroup].toObject(), groupsById);
 	}
 
 	subjects.clear();
-	for (auto const &jsonSubject: json["subjects"].toArray()) {
-		subjects.push_back(Subject(jsonSubject.toObject()));
+	auto const &jsonSubjects = json["subjects"].toArray();
+	subjects.reserve(jsonSubjects.size());
+	for (auto const &jsonSubject: jsonSubjects) {
+		subjects.push_back(Subject(subjects.size(), jsonSubject.toObject()));
 	}
+	auto const &subjectsById = getEntitiesById(subjects);
 
 	teachers.clear();
-	for (auto const &jsonTeacher: json["teachers"].toArray()) {
-		teachers.push_back(Teacher(jsonTeacher.toObject(), subjects));
+	auto const &jsonTeachers = json["teachers"].toArray();
+	teachers.reserve(jsonTeachers.size());
+	for (auto const &jsonTeacher: jsonTeachers) {
+		teachers.push_back(Teacher(teachers.size(), jsonTeacher.toObject(), subjectsById));
 	}
 
 	trios.clear();
-	for (auto const &jsonTrio: json["trios"].toArray()) {
-		trios.push_back(Trio(jsonTrio.toObject(), groups));
+	auto const &jsonTrios = json["trios"].toArray();
+	trios.reserve(jsonTrios.size());
+	for (auto const &jsonTrio: jsonTrios) {
+		trios.push_back(Trio(jsonTrio.toObject(), groupsById));
 	}
 
 	weeks.clear();
-	for (auto const &jsonWeek: json["weeks"].toArray()) {
+	auto const &jsonWeeks = json["weeks"].toArray();
+	weeks.reserve(jsonWeeks.size());
+	for (auto const &jsonWeek: jsonWeeks) {
 		weeks.push_back(Week(jsonWeek.toObject()));
 	}
 
-	int index = 0;
-	for (auto const &jsonObjective: json["objectives"].toArray()) {
-		auto const &name = jsonObjective.toString();
-		std::iter_swap(
-			objectives.begin() + index,
-			std::ranges::find_if(objectives, [&](auto const &objective) {
-				return objective->getName() == name;
-			})
-		);
-		++index;
-	}
+	importObjectives(json["objectives"].toArray());
 
 	forbiddenSubjectsCombination.clear();
 	for (auto const &jsonSubject: json["forbiddenSubjectIdsCombination"].toArray()) {
-		forbiddenSubjectsCombination.push_back(
-			&*std::ranges::find_if(subjects, [&](auto const &subject) { return subject.getId() == jsonSubject.toString(); })
-		);
+		forbiddenSubjectsCombination.push_back(subjectsById.at(jsonSubject.toString()));
 	}
 
 	auto const &jsonLunchTimeRange = json["lunchTimeRange"].toArray();
 	lunchTimeRange = {jsonLunchTimeRange[0].toInt(), jsonLunchTimeRange[1].toInt()};
+
+	solverParameters = SolverParameters(json["solverParameters"].toObject());
+	computeIndexes();
+
+	return true;
+}
+
+/** Whether every referenced id exists and the state can be computed, so that untrusted data can be imported without throwing or dividing by zero */
+bool State::validate(QJsonObject const &json)
+{
+	std::set<QString> groupIds;
+	for (auto const &jsonGroup: json["groups"].toArray()) {
+		groupIds.insert(jsonGroup.toObject()["id"].toString());
+	}
+
+	for (auto const &jsonGroup: json["groups"].toArray()) {
+		auto const &jsonNextGroupId = jsonGroup.toObject()["nextGroupId"];
+		if (!jsonNextGroupId.isUndefined() && !jsonNextGroupId.isNull() && !groupIds.contains(jsonNextGroupId.toString())) {
+			return false;
+		}
+	}
+
+	for (auto const &jsonTrio: json["trios"].toArray()) {
+		for (auto const &jsonInitialGroupId: jsonTrio.toObject()["initialGroupIds"].toArray()) {
+			if (!groupIds.contains(jsonInitialGroupId.toString())) {
+				return false;
+			}
+		}
+	}
+
+	std::vector<Subject> subjects;
+	for (auto const &jsonSubject: json["subjects"].toArray()) {
+		subjects.push_back(Subject(subjects.size(), jsonSubject.toObject()));
+	}
+	auto const &subjectsById = getEntitiesById(subjects);
+
+	std::vector<int> weeklyAvailabilityFrequencies;
+	for (auto const &jsonTeacher: json["teachers"].toArray()) {
+		auto const &jsonTeacherObject = jsonTeacher.toObject();
+		if (!subjectsById.contains(jsonTeacherObject["subjectId"].toString())) {
+			return false;
+		}
+		weeklyAvailabilityFrequencies.push_back(jsonTeacherObject["weeklyAvailabilityFrequency"].toInt(1));
+	}
+
+	std::vector<Week> weeks;
+	for (auto const &jsonWeek: json["weeks"].toArray()) {
+		weeks.push_back(Week(jsonWeek.toObject()));
+	}
+
+	std::vector<Subject const *> forbiddenSubjectsCombination;
+	for (auto const &jsonSubjectId: json["forbiddenSubjectIdsCombination"].toArray()) {
+		auto const &subject = subjectsById.find(jsonSubjectId.toString());
+		if (subject == subjectsById.end()) {
+			return false;
+		}
+		forbiddenSubjectsCombination.push_back(subject->second);
+	}
+
+	return validate(subjects, weeklyAvailabilityFrequencies, weeks, forbiddenSubjectsCombination);
+}
+
+/**
+ * The checks shared by both imports, once the references have been resolved:
+ * - there is at least one week, and every frequency is positive;
+ * - the forbidden subjects combination does not rule out every subjects combination, the weeks of each subject being chosen as the solver does,
+ *   amongst its first `frequency` weeks, and the forbidden subjects only being looked for during the first cycle.
+ */
+bool State::validate(
+	std::vector<Subject> const &subjects,
+	std::vector<int> const &weeklyAvailabilityFrequencies,
+	std::vector<Week> const &weeks,
+	std::vector<Subject const *> const &forbiddenSubjectsCombination
+)
+{
+	if (
+		weeks.empty()
+		|| !std::ranges::all_of(subjects, [](auto const &subject) { return subject.getFrequency() > 0; })
+		|| !std::ranges::all_of(weeklyAvailabilityFrequencies, [](int frequency) { return frequency > 0; })
+	) {
+		return false;
+	}
+
+	if (forbiddenSubjectsCombination.empty()) {
+		return true;
+	}
+
+	// Only the number of weeks in the cycle matters, so it stops growing once it covers all the weeks
+	long long cycleDuration = 1;
+	for (auto const &subject: subjects) {
+		cycleDuration = std::min<long long>(std::lcm<long long>(cycleDuration, subject.getFrequency()), weeks.size());
+	}
+
+	// The weeks of the forbidden subjects are chosen one subject at a time, until none of the weeks of the cycle has all of them
+	std::function<bool(int, std::vector<Week> const &)> isCombinationAllowed = [&](int idForbiddenSubject, std::vector<Week> const &weeksWithAllSubjects) {
+		if (weeksWithAllSubjects.empty()) {
+			return true;
+		}
+		if (idForbiddenSubject == static_cast<int>(forbiddenSubjectsCombination.size())) {
+			return false;
+		}
+
+		int const frequency = forbiddenSubjectsCombination[idForbiddenSubject]->getFrequency();
+		for (auto const &startingWeek: weeks | std::views::take(frequency)) {
+			std::vector<Week> nextWeeksWithAllSubjects;
+			std::ranges::copy_if(weeksWithAllSubjects, std::back_inserter(nextWeeksWithAllSubjects), [&](auto const &week) {
+				int const distance = week.getId() - startingWeek.getId();
+				return distance >= 0 && distance % frequency == 0;
+			});
+
+			if (isCombinationAllowed(idForbiddenSubject + 1, nextWeeksWithAllSubjects)) {
+				return true;
+			}
+		}
+
+		return false;
+	};
+
+	return isCombinationAllowed(0, std::vector<Week>(weeks.begin(), weeks.begin() + cycleDuration));
+}
+
+std::set<Timeslot> readTimeslots(CborReader &reader)
+{
+	std::set<Timeslot> timeslots;
+	reader.readArray([&]() {
+		int day = 0;
+		int hour = 0;
+		reader.readMap([&](QString const &key) {
+			if (key == "day") { day = reader.readInt(); }
+			else if (key == "hour") { hour = reader.readInt(); }
+			else { reader.skip(); }
+		});
+		timeslots.insert(Timeslot(static_cast<Day>(day), hour));
+	});
+
+	return timeslots;
+}
+
+/**
+ * Imports a state encoded in CBOR, with the same structure as the JSON one, in a single pass and without building the intermediate tree.
+ * As the previous state is not kept, the import is always considered as a structural change.
+ * The data are validated as with the JSON import, so that untrusted data can be imported.
+ * @return Whether the data were valid; if not, the state is left unchanged.
+ */
+bool State::importCbor(QByteArray const &data)
+{
+	// The references between entities can only be resolved once everything has been read, as the keys can be in any order
+	struct GroupData { QString id, name; std::set<Timeslot> availableTimeslots; QString nextGroupId; int duration = 0; };
+	struct TeacherData { QString id, name, subjectId; std::set<Timeslot> availableTimeslots; int weeklyAvailabilityFrequency = 1; std::optional<double> meanWeeklyVolume; };
+	struct TrioData { int id = 0; std::vector<QString> initialGroupIds; };
+
+	std::vector<GroupData> groupsData;
+	std::vector<Subject> newSubjects;
+	std::vector<TeacherData> teachersData;
+	std::vector<TrioData> triosData;
+	std::vector<Week> newWeeks;
+	QJsonArray jsonObjectives;
+	std::vector<QString> forbiddenSubjectIds;
+	std::pair<int, int> newLunchTimeRange;
+	QJsonObject jsonSolverParameters;
+
+	CborReader reader(data);
+	reader.readMap([&](QString const &key) {
+		if (key == "groups") {
+			reader.readArray([&]() {
+				auto &groupData = groupsData.emplace_back();
+				reader.readMap([&](QString const &key) {
+					if (key == "id") { groupData.id = reader.readString(); }
+					else if (key == "name") { groupData.name = reader.readString(); }
+					else if (key == "availableTimeslots") { groupData.availableTimeslots = readTimeslots(reader); }
+					else if (key == "nextGroupId") { groupData.nextGroupId = reader.readString(); }
+					else if (key == "duration") { groupData.duration = reader.readInt(); }
+					else { reader.skip(); }
+				});
+			});
+		}
+		else if (key == "subjects") {
+			reader.readArray([&]() {
+				QString id, name, shortName;
+				int frequency = 0;
+				reader.readMap([&](QString const &key) {
+					if (key == "id") { id = reader.readString(); }
+					else if (key == "name") { name = reader.readString(); }
+					else if (key == "shortName") { shortName = reader.readString(); }
+					else if (key == "frequency") { frequency = reader.readInt(); }
+					else { reader.skip(); }
+				});
+				newSubjects.push_back(Subject(newSubjects.size(), id, name, shortName, frequency));
+			});
+		}
+		else if (key == "teachers") {
+			reader.readArray([&]() {
+				auto &teacherData = teachersData.emplace_back();
+				reader.readMap([&](QString const &key) {
+					if (key == "id") { teacherData.id = reader.readString(); }
+					else if (key == "name") { teacherData.name = reader.readString(); }
+					else if (key == "subjectId") { teacherData.subjectId = reader.readString(); }
+					else if (key == "availableTimeslots") { teacherData.availableTimeslots = readTimeslots(reader); }
+					else if (key == "weeklyAvailabilityFrequency") { teacherData.weeklyAvailabilityFrequency = reader.readInt(); }
+					else if (key == "meanWeeklyVolume" && !reader.isNull()) { teacherData.meanWeeklyVolume = reader.readDouble(); }
+					else { reader.skip(); }
+				});
+			});
+		}
+		else if (key == "trios") {
+			reader.readArray([&]() {
+				auto &trioData = triosData.emplace_back();
+				reader.readMap([&](QString const &key) {
+					if (key == "id") { trioData.id = reader.readInt(); }
+					else if (key == "initialGroupIds") { reader.readArray([&]() { trioData.initialGroupIds.push_back(reader.readString()); }); }
+					else { reader.skip(); }
+				});
+			});
+		}
+		else if (key == "weeks") {
+			reader.readArray([&]() {
+				int id = 0;
+				int number = 0;
+				reader.readMap([&](QString const &key) {
+					if (key == "id") { id = reader.readInt(); }
+					else if (key == "number") { number = reader.readInt(); }
+					else { reader.skip(); }
+				});
+				newWeeks.push_back(Week(id, number));
+			});
+		}
+		else if (key == "objectives") {
+			jsonObjectives = reader.readJsonValue().toArray();
+		}
+		else if (key == "forbiddenSubjectIdsCombination") {
+			reader.readArray([&]() { forbiddenSubjectIds.push_back(reader.readString()); });
+		}
+		else if (key == "lunchTimeRange") {
+			std::vector<int> bounds;
+			reader.readArray([&]() { bounds.push_back(reader.readInt()); });
+			if (bounds.size() == 2) {
+				newLunchTimeRange = {bounds[0], bounds[1]};
+			}
+		}
+		else if (key == "solverParameters") {
+			jsonSolverParameters = reader.readJsonValue().toObject();
+		}
+		else {
+			reader.skip();
+		}
+	});
+
+	if (reader.hasError()) {
+		return false;
+	}
+
+	std::vector<Group> newGroups;
+	newGroups.reserve(groupsData.size());
+	for (auto const &groupData: groupsData) {
+		newGroups.push_back(Group(newGroups.size(), groupData.id, groupData.name, groupData.availableTimeslots));
+	}
+	auto const &groupsById = getEntitiesById(newGroups);
+	auto const &subjectsById = getEntitiesById(newSubjects);
+
+	auto const &areIdsKnown = [](auto const &entitiesById, auto const &ids) {
+		return std::ranges::all_of(ids, [&](auto const &id) { return entitiesById.contains(id); });
+	};
+	if (
+		!std::ranges::all_of(groupsData, [&](auto const &groupData) { return groupData.nextGroupId.isEmpty() || groupsById.contains(groupData.nextGroupId); })
+		|| !std::ranges::all_of(teachersData, [&](auto const &teacherData) { return subjectsById.contains(teacherData.subjectId); })
+		|| !std::ranges::all_of(triosData, [&](auto const &trioData) { return areIdsKnown(groupsById, trioData.initialGroupIds); })
+		|| !areIdsKnown(subjectsById, forbiddenSubjectIds)
+	) {
+		return false;
+	}
+
+	std::vector<int> weeklyAvailabilityFrequencies;
+	for (auto const &teacherData: teachersData) {
+		weeklyAvailabilityFrequencies.push_back(teacherData.weeklyAvailabilityFrequency);
+	}
+
+	std::vector<Subject const *> newForbiddenSubjectsCombination;
+	for (auto const &forbiddenSubjectId: forbiddenSubjectIds) {
+		newForbiddenSubjectsCombination.push_back(subjectsById.at(forbiddenSubjectId));
+	}
+
+	if (!validate(newSubjects, weeklyAvailabilityFrequencies, newWeeks, newForbiddenSubjectsCombination)) {
+		return false;
+	}
+
+	for (int idGroup = 0; idGroup < newGroups.size(); ++idGroup) {
+		if (!groupsData[idGroup].nextGroupId.isEmpty()) {
+			newGroups[idGroup].setNextGroup(groupsData[idGroup].duration, *groupsById.at(groupsData[idGroup].nextGroupId));
+		}
+	}
+
+	std::vector<Teacher> newTeachers;
+	newTeachers.reserve(teachersData.size());
+	for (auto const &teacherData: teachersData) {
+		newTeachers.push_back(Teacher(
+			newTeachers.size(),
+			teacherData.id,
+			teacherData.name,
+			*subjectsById.at(teacherData.subjectId),
+			teacherData.availableTimeslots,
+			teacherData.weeklyAvailabilityFrequency,
+			teacherData.meanWeeklyVolume
+		));
+	}
+
+	std::vector<Trio> newTrios;
+	newTrios.reserve(triosData.size());
+	for (auto const &trioData: triosData) {
+		std::set<Group const *> initialGroups;
+		for (auto const &initialGroupId: trioData.initialGroupIds) {
+			initialGroups.insert(groupsById.at(initialGroupId));
+		}
+		newTrios.push_back(Trio(trioData.id, initialGroups));
+	}
+
+	// Moving the vectors keeps the addresses of their elements, and thus the pointers between entities, valid
+	groups = std::move(newGroups);
+	subjects = std::move(newSubjects);
+	teachers = std::move(newTeachers);
+	trios = std::move(newTrios);
+	weeks = std::move(newWeeks);
+	forbiddenSubjectsCombination = std::move(newForbiddenSubjectsCombination);
+	lunchTimeRange = newLunchTimeRange;
+	solverParameters = SolverParameters(jsonSolverParameters);
+	importObjectives(jsonObjectives);
+	computeIndexes();
+
+	changes = {true, {}, {}, {}, {}};
+	previousJson = QJsonObject();
+
+	return true;
+}
+
+/**
+ * Enables the objectives by order of importance, each one being given either by its name, or by an object with its name and optionally `enabled` and `weight`.
+ * The registered objectives which are not given are enabled after the other ones, and the unknown names are ignored.
+ */
+void State::importObjectives(QJsonArray const &jsonObjectives)
+{
+	ownedObjectives.clear();
+	objectives.clear();
+	objectiveWeights.clear();
+
+	auto const &enableObjective = [&](QString const &name, int weight) {
+		auto const &objective = ownedObjectives.emplace_back(objectiveRegistry.create(name));
+		objectives.push_back(objective.get());
+		objectiveWeights[objective.get()] = weight;
+	};
+
+	std::set<QString> givenNames;
+	for (auto const &jsonObjective: jsonObjectives) {
+		auto const &jsonObjectiveObject = jsonObjective.isString() ? QJsonObject({{"name", jsonObjective}}) : jsonObjective.toObject();
+		auto const &name = jsonObjectiveObject["name"].toString();
+		if (!objectiveRegistry.contains(name) || givenNames.contains(name)) {
+			continue;
+		}
+
+		givenNames.insert(name);
+		if (jsonObjectiveObject["enabled"].toBool(true)) {
+			enableObjective(name, std::max(0, jsonObjectiveObject["weight"].toInt(1)));
+		}
+	}
+
+	for (auto const &name: objectiveRegistry.getNames()) {
+		if (!givenNames.contains(name)) {
+			enableObjective(name, 1);
+		}
+	}
 }
 
 const std::vector<Group>& State::getGroups() const
@@ -93,6 +491,11 @@ const std::vector<const Objective*>& State::getObjectives() const
 	return objectives;
 }
 
+int State::getObjectiveWeight(Objective const *objective) const
+{
+	return objectiveWeights.at(objective);
+}
+
 const std::vector<const Subject*>& State::getForbiddenSubjectsCombination() const
 {
 	return forbiddenSubjectsCombination;
@@ -103,28 +506,112 @@ const std::pair<int, int>& State::getLunchTimeRange() const
 	return lunchTimeRange;
 }
 
-std::vector<Teacher> State::getTeachersOfSubject(const Subject& subject) const
+const SolverParameters& State::getSolverParameters() const
+{
+	return solverParameters;
+}
+
+const StateChanges& State::getChanges() const
 {
-	std::vector<Teacher> teachersOfSubject;
+	return changes;
+}
+
+template <typename Id>
+std::set<Id> getChangedIds(QJsonArray const &previousJsonEntities, QJsonArray const &jsonEntities, std::function<Id(QJsonObject const &)> const &getId)
+{
+	std::map<Id, QJsonObject> previousJsonEntitiesById;
+	for (auto const &previousJsonEntity: previousJsonEntities) {
+		auto const &previousJsonEntityObject = previousJsonEntity.toObject();
+		previousJsonEntitiesById[getId(previousJsonEntityObject)] = previousJsonEntityObject;
+	}
+
+	std::set<Id> changedIds;
+	for (auto const &jsonEntity: jsonEntities) {
+		auto const &jsonEntityObject = jsonEntity.toObject();
+		auto const &id = getId(jsonEntityObject);
+		auto const &previousJsonEntity = previousJsonEntitiesById.find(id);
+
+		if (previousJsonEntity == previousJsonEntitiesById.end()) {
+			changedIds.insert(id);
+			continue;
+		}
+
+		if (previousJsonEntity->second != jsonEntityObject) {
+			changedIds.insert(id);
+		}
+		previousJsonEntitiesById.erase(previousJsonEntity);
+	}
+
+	// The remaining entities have been removed
+	for (auto const &[id, previousJsonEntity]: previousJsonEntitiesById) {
+		changedIds.insert(id);
+	}
+
+	return changedIds;
+}
+
+StateChanges State::computeChanges(QJsonObject const &json) const
+{
+	auto const &getStringId = [](QJsonObject const &json) { return json["id"].toString(); };
+	auto const &getIntId = [](QJsonObject const &json) { return json["id"].toInt(); };
+
+	StateChanges newChanges = {
+		previousJson.isEmpty(),
+		getChangedIds<QString>(previousJson["groups"].toArray(), json["groups"].toArray(), getStringId),
+		getChangedIds<QString>(previousJson["teachers"].toArray(), json["teachers"].toArray(), getStringId),
+		getChangedIds<int>(previousJson["trios"].toArray(), json["trios"].toArray(), getIntId),
+		getChangedIds<int>(previousJson["weeks"].toArray(), json["weeks"].toArray(), getIntId),
+	};
+
+	for (auto const &key: json.keys()) {
+		if (key != "groups" && key != "teachers" && key != "trios" && key != "weeks" && json[key] != previousJson[key]) {
+			newChanges.isStructural = true;
+		}
+	}
+
+	return newChanges;
+}
+
+/** Precomputes what the solver and the objectives look up in their loops, once the entities have been imported */
+void State::computeIndexes()
+{
+	teachersBySubject.assign(subjects.size(), {});
 	for (auto const &teacher: teachers) {
-		if (teacher.getSubject() == subject) {
-			teachersOfSubject.push_back(teacher);
+		teachersBySubject[teacher.getSubject().getIndex()].push_back(teacher);
+	}
+
+	availableTimeslotsByTrioAndWeek.clear();
+	availableTimeslotsByTrioAndWeek.reserve(trios.size());
+	for (auto const &trio: trios) {
+		auto &availableTimeslotsByWeek = availableTimeslotsByTrioAndWeek[trio];
+		availableTimeslotsByWeek.reserve(weeks.size());
+		for (auto const &week: weeks) {
+			availableTimeslotsByWeek[week] = trio.getAvailableTimeslotsInWeek(week);
 		}
 	}
+}
 
-	return teachersOfSubject;
+std::vector<std::reference_wrapper<Teacher const>> const &State::getTeachersOfSubject(const Subject& subject) const
+{
+	return teachersBySubject[subject.getIndex()];
+}
+
+std::set<Timeslot> const &State::getAvailableTimeslots(Trio const &trio, Week const &week) const
+{
+	return availableTimeslotsByTrioAndWeek.at(trio).at(week);
 }
 
-std::set<Timeslot> State::getAvailableTimeslots(Teacher const &teacher, Trio const &trio, Week const &week) const
+std::vector<Timeslot> State::getAvailableTimeslots(Teacher const &teacher, Trio const &trio, Week const &week) const
 {
-	std::set<Timeslot> availableTimeslots;
 	auto const &availableTimeslotsTeacher = teacher.getAvailableTimeslots();
-	auto const &availableTimeslotsTrio = trio.getAvailableTimeslotsInWeek(week);
+	auto const &availableTimeslotsTrio = getAvailableTimeslots(trio, week);
 
+	std::vector<Timeslot> availableTimeslots;
+	availableTimeslots.reserve(std::min(availableTimeslotsTeacher.size(), availableTimeslotsTrio.size()));
 	std::ranges::set_intersection(
 		availableTimeslotsTeacher,
 		availableTimeslotsTrio,
-		std::inserter(availableTimeslots, availableTimeslots.end())
+		std::back_inserter(availableTimeslots)
 	);
 
 	return availableTimeslots;
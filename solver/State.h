@@ -1,24 +1,46 @@
 #pragma once
 
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+#include <functional>
+#include <memory>
 #include <vector>
 #include <set>
+#include <unordered_map>
 #include <utility>
 #include "Group.h"
+#include "Objective/ObjectiveRegistry.h"
+#include "SolverParameters.h"
 #include "Subject.h"
 #include "Teacher.h"
 #include "Trio.h"
 #include "Week.h"
 
-class QJsonObject;
+class QJsonArray;
 class Objective;
 class Slot;
 class Timeslot;
 
+/** The entities that have changed since the previous import */
+struct StateChanges {
+	/** Whether something else than the teachers, the groups, the trios or the weeks has changed */
+	bool isStructural;
+
+	std::set<QString> groupIds;
+	std::set<QString> teacherIds;
+	std::set<int> trioIds;
+	std::set<int> weekIds;
+};
+
 class State
 {
 	public:
-		State(std::vector<Objective const *> const &objectives);
-		void import(QJsonObject const &json);
+		explicit State(ObjectiveRegistry const &objectiveRegistry = ObjectiveRegistry::getDefault());
+		~State();
+		bool import(QJsonObject const &json);
+		bool importCbor(QByteArray const &data);
+		static bool validate(QJsonObject const &json);
 
 		const std::vector<Group>& getGroups() const;
 		const std::vector<Subject>& getSubjects() const;
@@ -26,13 +48,17 @@ class State
 		const std::vector<Trio>& getTrios() const;
 		const std::vector<Week>& getWeeks() const;
 		const std::vector<const Objective*>& getObjectives() const;
+		int getObjectiveWeight(Objective const *objective) const;
 		const std::vector<const Subject*>& getForbiddenSubjectsCombination() const;
 		const std::pair<int, int>& getLunchTimeRange() const;
+		const SolverParameters& getSolverParameters() const;
+		const StateChanges& getChanges() const;
 
-		std::vector<Teacher> getTeachersOfSubject(Subject const &subject) const;
+		std::vector<std::reference_wrapper<Teacher const>> const &getTeachersOfSubject(Subject const &subject) const;
 		std::vector<std::pair<Slot, Slot>> getNotSimultaneousSameDaySlotsWithDifferentSubjects() const;
 		std::vector<std::pair<Slot, Slot>> getConsecutiveSlotsWithDifferentSubjects() const;
-		std::set<Timeslot> getAvailableTimeslots(Teacher const &teacher, Trio const &trio, Week const &week) const;
+		std::set<Timeslot> const &getAvailableTimeslots(Trio const &trio, Week const &week) const;
+		std::vector<Timeslot> getAvailableTimeslots(Teacher const &teacher, Trio const &trio, Week const &week) const;
 
 	protected:
 		std::vector<Group> groups;
@@ -40,8 +66,30 @@ class State
 		std::vector<Teacher> teachers;
 		std::vector<Trio> trios;
 		std::vector<Week> weeks;
+		ObjectiveRegistry objectiveRegistry;
+		std::vector<std::unique_ptr<Objective>> ownedObjectives;
+		/** Only the enabled objectives, by order of importance */
 		std::vector<Objective const *> objectives;
+		std::unordered_map<Objective const *, int> objectiveWeights;
 		std::vector<Subject const *> forbiddenSubjectsCombination;
 		std::pair<int, int> lunchTimeRange;
+		SolverParameters solverParameters;
+
+		QJsonObject previousJson;
+		StateChanges changes;
+
+		/** Indexed by the index of the subject */
+		std::vector<std::vector<std::reference_wrapper<Teacher const>>> teachersBySubject;
+		std::unordered_map<Trio, std::unordered_map<Week, std::set<Timeslot>>> availableTimeslotsByTrioAndWeek;
+
+		StateChanges computeChanges(QJsonObject const &json) const;
+		void importObjectives(QJsonArray const &jsonObjectives);
+		static bool validate(
+			std::vector<Subject> const &subjects,
+			std::vector<int> const &weeklyAvailabilityFrequencies,
+			std::vector<Week> const &weeks,
+			std::vector<Subject const *> const &forbiddenSubjectsCombination
+		);
+		void computeIndexes();
 };
 
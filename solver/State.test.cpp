@@ -0,0 +1,130 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <QCborValue>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <algorithm>
+#include "Objective/Objective.h"
+#include "State.h"
+
+QJsonObject getJsonState()
+{
+	auto const &jsonTimeslots = QJsonArray({
+		QJsonObject({{"day", 0}, {"hour", 10}}),
+		QJsonObject({{"day", 2}, {"hour", 16}}),
+	});
+
+	return {
+		{"groups", QJsonArray({
+			QJsonObject({{"id", "A"}, {"name", "A"}, {"availableTimeslots", jsonTimeslots}, {"nextGroupId", "B"}, {"duration", 4}}),
+			QJsonObject({{"id", "B"}, {"name", "B"}, {"availableTimeslots", QJsonArray()}, {"nextGroupId", QJsonValue::Null}}),
+		})},
+		{"subjects", QJsonArray({
+			QJsonObject({{"id", "maths"}, {"name", "Maths"}, {"shortName", "M"}, {"frequency", 1}}),
+			QJsonObject({{"id", "physics"}, {"name", "Physics"}, {"shortName", "P"}, {"frequency", 2}}),
+			QJsonObject({{"id", "chemistry"}, {"name", "Chemistry"}, {"shortName", "C"}, {"frequency", 2}}),
+		})},
+		{"teachers", QJsonArray({
+			QJsonObject({{"id", "t1"}, {"name", "T1"}, {"subjectId", "physics"}, {"availableTimeslots", jsonTimeslots}, {"weeklyAvailabilityFrequency", 2}, {"meanWeeklyVolume", 1.5}}),
+			QJsonObject({{"id", "t2"}, {"name", "T2"}, {"subjectId", "maths"}, {"availableTimeslots", jsonTimeslots}, {"weeklyAvailabilityFrequency", 1}, {"meanWeeklyVolume", QJsonValue::Null}}),
+		})},
+		{"trios", QJsonArray({
+			QJsonObject({{"id", 0}, {"initialGroupIds", QJsonArray({"A", "B"})}}),
+		})},
+		{"weeks", QJsonArray({
+			QJsonObject({{"id", 0}, {"number", 36}}),
+			QJsonObject({{"id", 1}, {"number", 38}}),
+		})},
+		{"objectives", QJsonArray()},
+		{"lunchTimeRange", QJsonArray({12, 14})},
+		{"forbiddenSubjectIdsCombination", QJsonArray({"physics", "chemistry"})},
+		{"solverParameters", QJsonObject({{"periodicMode", true}})},
+	};
+}
+
+TEST_CASE("importCbor") {
+	State jsonState({});
+	jsonState.import(getJsonState());
+
+	State cborState({});
+	REQUIRE(cborState.importCbor(QCborValue::fromJsonValue(getJsonState()).toCbor()));
+
+	REQUIRE(cborState.getGroups().size() == jsonState.getGroups().size());
+	REQUIRE(cborState.getSubjects() == jsonState.getSubjects());
+	REQUIRE(cborState.getWeeks() == jsonState.getWeeks());
+	REQUIRE(cborState.getLunchTimeRange() == jsonState.getLunchTimeRange());
+	REQUIRE(cborState.getSolverParameters().isPeriodicModeEnabled());
+	REQUIRE(cborState.getChanges().isStructural);
+
+	REQUIRE(cborState.getTeachers().size() == 2);
+	REQUIRE(&cborState.getTeachers()[0].getSubject() == &cborState.getSubjects()[1]);
+	REQUIRE(cborState.getTeachers()[0].getTotalVolume(2).value == 3);
+	REQUIRE_FALSE(cborState.getTeachers()[1].hasMeanWeeklyVolume());
+
+	REQUIRE(cborState.getGroups()[0].getNextGroup() == &cborState.getGroups()[1]);
+	REQUIRE(cborState.getTrios()[0].getAvailableTimeslotsInWeek(cborState.getWeeks()[0]).size() == 2);
+	REQUIRE(cborState.getForbiddenSubjectsCombination() == std::vector<Subject const *>({&cborState.getSubjects()[1], &cborState.getSubjects()[2]}));
+}
+
+TEST_CASE("importCbor with invalid data") {
+	State state({});
+	state.import(getJsonState());
+
+	auto jsonState = getJsonState();
+	jsonState["teachers"] = QJsonArray({QJsonObject({{"id", "t1"}, {"subjectId", "unknown"}})});
+
+	REQUIRE_FALSE(state.importCbor(QCborValue::fromJsonValue(jsonState).toCbor()));
+	REQUIRE_FALSE(state.importCbor(QByteArray("\xa1\x66groups", 8)));
+	REQUIRE(state.getTeachers().size() == 2);
+}
+
+TEST_CASE("import with invalid data") {
+	State state({});
+	REQUIRE(state.import(getJsonState()));
+
+	// Each of these states would throw, or crash the solver, if it was imported
+	auto jsonState = getJsonState();
+	SECTION("unknown subject") {
+		jsonState["teachers"] = QJsonArray({QJsonObject({{"id", "t1"}, {"subjectId", "unknown"}})});
+	}
+	SECTION("unknown group") {
+		jsonState["trios"] = QJsonArray({QJsonObject({{"id", 0}, {"initialGroupIds", QJsonArray({"unknown"})}})});
+	}
+	SECTION("unknown forbidden subject") {
+		jsonState["forbiddenSubjectIdsCombination"] = QJsonArray({"unknown"});
+	}
+	SECTION("frequency of zero") {
+		jsonState["teachers"] = QJsonArray({QJsonObject({{"id", "t1"}, {"subjectId", "maths"}, {"weeklyAvailabilityFrequency", 0}})});
+	}
+	SECTION("no week") {
+		jsonState["weeks"] = QJsonArray();
+	}
+	SECTION("forbidden subjects combination which is always there") {
+		jsonState["forbiddenSubjectIdsCombination"] = QJsonArray({"maths", "physics"});
+	}
+
+	REQUIRE_FALSE(State::validate(jsonState));
+	REQUIRE_FALSE(state.import(jsonState));
+	REQUIRE_FALSE(state.importCbor(QCborValue::fromJsonValue(jsonState).toCbor()));
+	REQUIRE(state.getTeachers().size() == 2);
+}
+
+TEST_CASE("importObjectives") {
+	State state;
+	auto jsonState = getJsonState();
+	jsonState["objectives"] = QJsonArray({
+		"No consecutive colles",
+		QJsonObject({{"name", "Unknown"}}),
+		QJsonObject({{"name", "Same slot only once in cycle"}, {"enabled", false}}),
+		QJsonObject({{"name", "Only one colle per day"}, {"weight", 3}}),
+	});
+	state.import(jsonState);
+
+	auto const &objectives = state.getObjectives();
+	REQUIRE(objectives.size() == 4);
+	REQUIRE(objectives[0]->getName() == "No consecutive colles");
+	REQUIRE(objectives[1]->getName() == "Only one colle per day");
+	REQUIRE(state.getObjectiveWeight(objectives[0]) == 1);
+	REQUIRE(state.getObjectiveWeight(objectives[1]) == 3);
+	REQUIRE(std::ranges::none_of(objectives, [](auto const &objective) { return objective->getName() == "Same slot only once in cycle"; }));
+}
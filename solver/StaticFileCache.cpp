@@ -0,0 +1,157 @@
+#include "StaticFileCache.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QHttpServerRequest>
+#include <QHttpServerResponder>
+#include <QHttpServerResponse>
+#include <QMimeDatabase>
+#include <QUrl>
+#include <array>
+#include <cstdint>
+
+StaticFileCache::StaticFileCache(QString const &rootPath)
+{
+	QDir const rootDir(rootPath);
+	QMimeDatabase const mimeDatabase;
+
+	QDirIterator iterator(rootPath, QDir::Files, QDirIterator::Subdirectories);
+	while (iterator.hasNext()) {
+		auto const &fileInfo = iterator.nextFileInfo();
+		if (fileInfo.suffix() == "br" || fileInfo.suffix() == "gz") {
+			continue;
+		}
+
+		QFile file(fileInfo.filePath());
+		if (!file.open(QIODevice::ReadOnly)) {
+			continue;
+		}
+
+		StaticFile staticFile;
+		staticFile.content = file.readAll();
+		staticFile.mimeType = mimeDatabase.mimeTypeForFile(fileInfo).name().toUtf8();
+		staticFile.eTag = '"' + QCryptographicHash::hash(staticFile.content, QCryptographicHash::Sha1).toHex() + '"';
+
+		auto const &gzipContent = gzip(staticFile.content);
+		if (gzipContent.size() < staticFile.content.size() * 0.9) {
+			staticFile.gzipContent = gzipContent;
+		}
+
+		QFile brotliFile(fileInfo.filePath() + ".br");
+		if (brotliFile.open(QIODevice::ReadOnly)) {
+			staticFile.brotliContent = brotliFile.readAll();
+		}
+
+		files.emplace(rootDir.relativeFilePath(fileInfo.filePath()), std::move(staticFile));
+	}
+}
+
+bool StaticFileCache::contains(QString const &path) const
+{
+	return files.contains(path);
+}
+
+void StaticFileCache::respond(QHttpServerRequest const &request, QHttpServerResponder &&responder) const
+{
+	auto const &file = files.find(getPathFromUrl(request.url()));
+	if (file == files.end()) {
+		return responder.write(QHttpServerResponder::StatusCode::NotFound);
+	}
+
+	auto const &staticFile = file->second;
+	auto const &acceptEncodingHeader = request.value("Accept-Encoding");
+	QByteArray contentEncoding;
+	auto const *content = &staticFile.content;
+	if (!staticFile.brotliContent.isEmpty() && acceptsEncoding(acceptEncodingHeader, "br")) {
+		contentEncoding = "br";
+		content = &staticFile.brotliContent;
+	}
+	else if (!staticFile.gzipContent.isEmpty() && acceptsEncoding(acceptEncodingHeader, "gzip")) {
+		contentEncoding = "gzip";
+		content = &staticFile.gzipContent;
+	}
+
+	// Each encoding is a different representation of the file, so it needs its own entity tag
+	auto const &eTag = contentEncoding.isEmpty() ? staticFile.eTag : staticFile.eTag.chopped(1) + '-' + contentEncoding + '"';
+
+	bool const isNotModified = request.value("If-None-Match") == eTag;
+	auto response = isNotModified
+		? QHttpServerResponse(QHttpServerResponder::StatusCode::NotModified)
+		: QHttpServerResponse(staticFile.mimeType, *content);
+	response.setHeader("ETag", eTag);
+	response.setHeader("Cache-Control", "no-cache");
+	response.setHeader("Vary", "Accept-Encoding");
+	if (!contentEncoding.isEmpty() && !isNotModified) {
+		response.setHeader("Content-Encoding", contentEncoding);
+	}
+
+	responder.sendResponse(response);
+}
+
+/**
+ * `qCompress` produces a zlib stream prefixed by the size of the data,
+ * whose raw deflate data is rewrapped in a gzip header and footer.
+ * @link https://www.rfc-editor.org/rfc/rfc1952
+ */
+QByteArray StaticFileCache::gzip(QByteArray const &data)
+{
+	if (data.isEmpty()) {
+		return {};
+	}
+
+	static auto const crcTable = [] {
+		std::array<std::uint32_t, 256> table;
+		for (std::uint32_t i = 0; i < table.size(); ++i) {
+			std::uint32_t value = i;
+			for (int bit = 0; bit < 8; ++bit) {
+				value = (value & 1) ? 0xEDB88320 ^ (value >> 1) : value >> 1;
+			}
+			table[i] = value;
+		}
+		return table;
+	}();
+
+	std::uint32_t crc = 0xFFFFFFFF;
+	for (auto const byte: data) {
+		crc = crcTable[(crc ^ static_cast<std::uint8_t>(byte)) & 0xFF] ^ (crc >> 8);
+	}
+	crc ^= 0xFFFFFFFF;
+
+	auto const &zlibData = qCompress(data, 9);
+	int const zlibPrefixSize = 4 + 2;
+	int const zlibSuffixSize = 4;
+
+	QByteArray gzipData("\x1f\x8b\x08\x00\x00\x00\x00\x00\x00\xff", 10);
+	gzipData.append(zlibData.constData() + zlibPrefixSize, zlibData.size() - zlibPrefixSize - zlibSuffixSize);
+
+	std::uint32_t const size = data.size();
+	for (auto const value: {crc, size}) {
+		for (int byte = 0; byte < 4; ++byte) {
+			gzipData.append(static_cast<char>((value >> (8 * byte)) & 0xFF));
+		}
+	}
+
+	return gzipData;
+}
+
+bool StaticFileCache::acceptsEncoding(QByteArray const &acceptEncodingHeader, QByteArray const &encoding)
+{
+	for (auto const &acceptedEncoding: acceptEncodingHeader.split(',')) {
+		auto const &parameters = acceptedEncoding.split(';');
+		if (parameters[0].trimmed() != encoding) {
+			continue;
+		}
+
+		return parameters.size() < 2 || parameters[1].trimmed() != "q=0";
+	}
+
+	return false;
+}
+
+/** Any URL without a file extension is handled by the router of the user interface */
+QString StaticFileCache::getPathFromUrl(QUrl const &url)
+{
+	return url.fileName().contains('.') ? url.path().mid(1) : "index.html";
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <unordered_map>
+
+class QHttpServerRequest;
+class QHttpServerResponder;
+class QUrl;
+
+/** A file served by the HTTP server, with everything needed to answer a request precomputed */
+struct StaticFile {
+	QByteArray content;
+	QByteArray mimeType;
+	QByteArray eTag;
+
+	/** Empty when compressing the content is not worth it */
+	QByteArray gzipContent;
+
+	/** Only available when a precompressed `.br` file exists next to the original one */
+	QByteArray brotliContent;
+};
+
+class StaticFileCache
+{
+	public:
+		explicit StaticFileCache(QString const &rootPath);
+
+		bool contains(QString const &path) const;
+		void respond(QHttpServerRequest const &request, QHttpServerResponder &&responder) const;
+
+		static QByteArray gzip(QByteArray const &data);
+		static bool acceptsEncoding(QByteArray const &acceptEncodingHeader, QByteArray const &encoding);
+
+	protected:
+		/** Indexed by path relative to the root directory */
+		std::unordered_map<QString, StaticFile> files;
+
+		static QString getPathFromUrl(QUrl const &url);
+};
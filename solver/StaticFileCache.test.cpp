@@ -0,0 +1,88 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include "StaticFileCache.h"
+
+namespace {
+	/** Bit by bit, independently of the table used by the implementation */
+	std::uint32_t getCrc32(QByteArray const &data)
+	{
+		std::uint32_t crc = 0xFFFFFFFF;
+		for (auto const byte: data) {
+			crc ^= static_cast<std::uint8_t>(byte);
+			for (int bit = 0; bit < 8; ++bit) {
+				crc = (crc & 1) ? 0xEDB88320 ^ (crc >> 1) : crc >> 1;
+			}
+		}
+		return crc ^ 0xFFFFFFFF;
+	}
+
+	std::uint32_t readLittleEndian(QByteArray const &data)
+	{
+		std::uint32_t value = 0;
+		for (int byte = 3; byte >= 0; --byte) {
+			value = (value << 8) | static_cast<std::uint8_t>(data[byte]);
+		}
+		return value;
+	}
+
+	/** Rewrap the raw deflate data in the format of `qUncompress`, with the Adler-32 checksum of the expected data */
+	QByteArray gunzip(QByteArray const &gzipData, QByteArray const &expectedData)
+	{
+		std::uint32_t a = 1;
+		std::uint32_t b = 0;
+		for (auto const byte: expectedData) {
+			a = (a + static_cast<std::uint8_t>(byte)) % 65521;
+			b = (b + a) % 65521;
+		}
+		std::uint32_t const adler = (b << 16) | a;
+		std::uint32_t const size = readLittleEndian(gzipData.right(4));
+
+		QByteArray zlibData;
+		for (int byte = 3; byte >= 0; --byte) {
+			zlibData.append(static_cast<char>((size >> (8 * byte)) & 0xFF));
+		}
+		zlibData.append("\x78\xda", 2);
+		zlibData.append(gzipData.mid(10, gzipData.size() - 10 - 8));
+		for (int byte = 3; byte >= 0; --byte) {
+			zlibData.append(static_cast<char>((adler >> (8 * byte)) & 0xFF));
+		}
+
+		return qUncompress(zlibData);
+	}
+}
+
+TEST_CASE("acceptsEncoding") {
+	REQUIRE(StaticFileCache::acceptsEncoding("gzip, deflate, br", "br"));
+	REQUIRE(StaticFileCache::acceptsEncoding("gzip;q=1.0, identity; q=0.5", "gzip"));
+	REQUIRE_FALSE(StaticFileCache::acceptsEncoding("gzip;q=0, br", "gzip"));
+	REQUIRE_FALSE(StaticFileCache::acceptsEncoding("deflate", "gzip"));
+	REQUIRE_FALSE(StaticFileCache::acceptsEncoding("", "gzip"));
+}
+
+TEST_CASE("gzip") {
+	QByteArray const data(1000, 'a');
+	auto const &gzipData = StaticFileCache::gzip(data);
+
+	REQUIRE(gzipData.startsWith("\x1f\x8b\x08"));
+	REQUIRE(gzipData.size() < data.size());
+
+	// The footer ends with the size of the original data, in little endian
+	REQUIRE(gzipData.right(4) == QByteArray("\xe8\x03\x00\x00", 4));
+	REQUIRE(StaticFileCache::gzip({}).isEmpty());
+}
+
+TEST_CASE("gzip round trip") {
+	QByteArray data;
+	for (int i = 0; i < 10000; ++i) {
+		data.append(QByteArray::number(i * i % 997)).append(' ');
+	}
+	auto const &gzipData = StaticFileCache::gzip(data);
+
+	REQUIRE(gunzip(gzipData, data) == data);
+	REQUIRE(readLittleEndian(gzipData.right(8)) == getCrc32(data));
+	REQUIRE(readLittleEndian(gzipData.right(4)) == static_cast<std::uint32_t>(data.size()));
+
+	// The check value of CRC-32
+	REQUIRE(readLittleEndian(StaticFileCache::gzip("123456789").right(8)) == 0xCBF43926);
+}
@@ -2,13 +2,14 @@
 
 #include <QJsonObject>
 
-Subject::Subject(QString const &id, const QString &name, const QString &shortName, int frequency):
-	id(id), name(name), shortName(shortName), frequency(frequency)
+Subject::Subject(int index, QString const &id, const QString &name, const QString &shortName, int frequency):
+	index(index), id(id), name(name), shortName(shortName), frequency(frequency)
 {
 
 }
 
-Subject::Subject(const QJsonObject& json):
+Subject::Subject(int index, const QJsonObject& json):
+	index(index),
 	id(json["id"].toString()),
 	name(json["name"].toString()),
 	shortName(json["shortName"].toString()),
@@ -16,6 +17,11 @@ Subject::Subject(const QJsonObject& json):
 {
 }
 
+int Subject::getIndex() const
+{
+	return index;
+}
+
 QString const &Subject::getId() const
 {
 	return id;
@@ -36,7 +42,12 @@ int Subject::getFrequency() const
 	return frequency;
 }
 
+bool Subject::operator==(Subject const &subject) const
+{
+	return index == subject.index;
+}
+
 size_t std::hash<Subject>::operator()(const Subject& subject) const
 {
-	return std::hash<QString>()(subject.getId());
+	return std::hash<int>()(subject.getIndex());
 }
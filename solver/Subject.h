@@ -8,17 +8,20 @@ class QJsonObject;
 class Subject
 {
 	public:
-		Subject(QString const &id, QString const &name, QString const &shortName, int frequency);
-		explicit Subject(QJsonObject const &json);
+		Subject(int index, QString const &id, QString const &name, QString const &shortName, int frequency);
+		Subject(int index, QJsonObject const &json);
 
+		int getIndex() const;
 		QString const &getId() const;
 		QString const &getName() const;
 		QString const &getShortName() const;
 		int getFrequency() const;
 
-		bool operator==(Subject const &) const = default;
+		bool operator==(Subject const &subject) const;
 
 	protected:
+		/** Position in the imported subjects, used instead of the id for the comparisons and hashes */
+		int index;
 		QString id;
 		QString name;
 		QString shortName;
@@ -4,23 +4,29 @@
 #include <QJsonObject>
 #include "Subject.h"
 
-Teacher::Teacher(QString const &id, QString const &name, Subject const &subject, std::set<Timeslot> const &availableTimeslots, int weeklyAvailabilityFrequency, std::optional<double> meanWeeklyVolume):
-	id(id), name(name), subject(&subject), availableTimeslots(availableTimeslots), weeklyAvailabilityFrequency(weeklyAvailabilityFrequency), meanWeeklyVolume(meanWeeklyVolume)
+Teacher::Teacher(int index, QString const &id, QString const &name, Subject const &subject, std::set<Timeslot> const &availableTimeslots, int weeklyAvailabilityFrequency, std::optional<double> meanWeeklyVolume):
+	index(index), id(id), name(name), subject(&subject), availableTimeslots(availableTimeslots), weeklyAvailabilityFrequency(weeklyAvailabilityFrequency), meanWeeklyVolume(meanWeeklyVolume)
 {
 
 }
 
-Teacher::Teacher(QJsonObject const &json, std::vector<Subject> const &subjects): Teacher(
+Teacher::Teacher(int index, QJsonObject const &json, std::unordered_map<QString, Subject const *> const &subjectsById): Teacher(
+	index,
 	json["id"].toString(),
 	json["name"].toString(),
-	*std::ranges::find_if(subjects, [&](auto const &subject) { return subject.getId() == json["subjectId"].toString(); }),
+	*subjectsById.at(json["subjectId"].toString()),
 	Timeslot::getSet(json["availableTimeslots"].toArray()),
-	json["weeklyAvailabilityFrequency"].toInt(),
+	json["weeklyAvailabilityFrequency"].toInt(1),
 	json["meanWeeklyVolume"].isNull() ? std::nullopt : std::optional(json["meanWeeklyVolume"].toDouble())
 )
 {
 }
 
+int Teacher::getIndex() const
+{
+	return index;
+}
+
 QString const &Teacher::getId() const
 {
 	return id;
@@ -70,7 +76,12 @@ bool Teacher::isAvailableAtTimeslot(const Timeslot &timeslot) const
 	return availableTimeslots.contains(timeslot);
 }
 
+bool Teacher::operator==(Teacher const &teacher) const
+{
+	return index == teacher.index;
+}
+
 size_t std::hash<Teacher>::operator()(const Teacher& teacher) const
 {
-	return std::hash<QString>()(teacher.getId());
+	return std::hash<int>()(teacher.getIndex());
 }
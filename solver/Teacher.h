@@ -4,6 +4,7 @@
 #include <functional>
 #include <optional>
 #include <set>
+#include <unordered_map>
 #include <vector>
 #include "Timeslot.h"
 
@@ -18,10 +19,11 @@ struct TeacherTotalVolume {
 class Teacher
 {
 	public:
-		Teacher(QString const &id, QString const &name, Subject const &subject, std::set<Timeslot> const &availableTimeslots, int weeklyAvailabilityFrequency, std::optional<double> meanWeeklyVolume);
-		Teacher(QString const &id, QString const &name, Subject const &&subject, std::set<Timeslot> const &availableTimeslots, int weeklyAvailabilityFrequency, std::optional<double> meanWeeklyVolume) = delete;
-		Teacher(QJsonObject const &json, std::vector<Subject> const &subjects);
+		Teacher(int index, QString const &id, QString const &name, Subject const &subject, std::set<Timeslot> const &availableTimeslots, int weeklyAvailabilityFrequency, std::optional<double> meanWeeklyVolume);
+		Teacher(int index, QString const &id, QString const &name, Subject const &&subject, std::set<Timeslot> const &availableTimeslots, int weeklyAvailabilityFrequency, std::optional<double> meanWeeklyVolume) = delete;
+		Teacher(int index, QJsonObject const &json, std::unordered_map<QString, Subject const *> const &subjectsById);
 
+		int getIndex() const;
 		QString const &getId() const;
 		QString const &getName() const;
 		Subject const &getSubject() const;
@@ -33,9 +35,11 @@ class Teacher
 
 		bool isAvailableAtTimeslot(Timeslot const &timeslot) const;
 
-		bool operator==(Teacher const &) const = default;
+		bool operator==(Teacher const &teacher) const;
 
 	protected:
+		/** Position in the imported teachers, used instead of the id for the comparisons and hashes */
+		int index;
 		QString id;
 		QString name;
 		Subject const *subject;
@@ -4,10 +4,10 @@
 #include "Teacher.h"
 
 TEST_CASE("getTotalVolume") {
-    Subject subject("subject", "subject", "s", 1);
-    Teacher teacher1("1", "1", subject, {}, 1, 1);
-    Teacher teacher2("1", "1", subject, {}, 1, 1.5);
-    Teacher teacher3("1", "1", subject, {}, 1, 1.333);
+    Subject subject(0, "subject", "subject", "s", 1);
+    Teacher teacher1(0, "1", "1", subject, {}, 1, 1);
+    Teacher teacher2(0, "1", "1", subject, {}, 1, 1.5);
+    Teacher teacher3(0, "1", "1", subject, {}, 1, 1.333);
     int const nbWeeks = 3;
 
     auto const &result1 = teacher1.getTotalVolume(nbWeeks);
@@ -9,14 +9,13 @@ Trio::Trio(int id, const std::set<const Group*>& initialGroups): id(id), initial
 
 }
 
-Trio::Trio(const QJsonObject& json, const std::vector<Group>& groups): Trio(
+Trio::Trio(const QJsonObject& json, const std::unordered_map<QString, const Group*>& groupsById): Trio(
 	json["id"].toInt(),
 	{}
 )
 {
 	for (auto const &jsonInitialGroupId: json["initialGroupIds"].toArray()) {
-		auto const &group = &*std::ranges::find_if(groups, [&](auto const &group) { return group.getId() == jsonInitialGroupId.toString(); });
-		initialGroups.insert(group);
+		initialGroups.insert(groupsById.at(jsonInitialGroupId.toString()));
 	}
 }
 
@@ -36,6 +35,29 @@ std::set<Timeslot> Trio::getAvailableTimeslotsInWeek(Week const &week) const
 	return availableTimeslots;
 }
 
+/** Whether one of the given groups is an initial group of the trio, or one of the groups they rotate to */
+bool Trio::dependsOnGroups(std::set<QString> const &groupIds) const
+{
+	std::set<Group const *> visitedGroups;
+	for (auto group: initialGroups) {
+		while (group != nullptr && !visitedGroups.contains(group)) {
+			if (groupIds.contains(group->getId())) {
+				return true;
+			}
+
+			visitedGroups.insert(group);
+			group = group->getNextGroup();
+		}
+	}
+
+	return false;
+}
+
+bool Trio::operator==(Trio const &trio) const
+{
+	return id == trio.id;
+}
+
 size_t std::hash<Trio>::operator()(const Trio& trio) const
 {
 	return std::hash<int>()(trio.getId());
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <QString>
 #include <functional>
 #include <set>
+#include <unordered_map>
 
 class QJsonObject;
 class Group;
@@ -12,12 +14,13 @@ class Trio
 {
 	public:
 		Trio(int id, std::set<Group const *> const &initialGroups);
-		Trio(QJsonObject const &json, std::vector<Group> const &groups);
+		Trio(QJsonObject const &json, std::unordered_map<QString, Group const *> const &groupsById);
 
 		int getId() const;
 		std::set<Timeslot> getAvailableTimeslotsInWeek(Week const &week) const;
+		bool dependsOnGroups(std::set<QString> const &groupIds) const;
 
-		bool operator==(Trio const &) const = default;
+		bool operator==(Trio const &trio) const;
 
 	protected:
 		int id;
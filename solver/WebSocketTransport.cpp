@@ -1,27 +1,96 @@
 #include "WebSocketTransport.h"
 
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QMetaMethod>
 #include <QWebSocket>
+#include <algorithm>
+#include <iterator>
+
+std::set<WebSocketTransport const*> WebSocketTransport::instances;
 
 WebSocketTransport::WebSocketTransport(QWebSocket *socket)
 	: QWebChannelAbstractTransport(socket), socket(socket)
 {
 	connect(socket, &QWebSocket::textMessageReceived, this, &WebSocketTransport::textMessageReceived);
+	connect(socket, &QWebSocket::bytesWritten, this, &WebSocketTransport::bytesWritten);
 	connect(socket, &QWebSocket::disconnected, this, &WebSocketTransport::deleteLater);
+	instances.insert(this);
 }
 
 
 WebSocketTransport::~WebSocketTransport()
 {
+	instances.erase(this);
 	socket->deleteLater();
 }
 
 
 void WebSocketTransport::sendMessage(QJsonObject const &message)
 {
-	QJsonDocument doc(message);
-	socket->sendTextMessage(QString::fromUtf8(doc.toJson(QJsonDocument::Compact)));
+	// Queued messages are only there while the socket is behind, so they are the only ones which can be replaced.
+	// A message which is not coalesced keeps the ones queued before it, which are then sent as they are, in order.
+	if (isCoalesced(message)) {
+		auto const firstReplaceableMessage = std::find_if_not(queuedMessages.rbegin(), queuedMessages.rend(), [&](auto const &queuedMessage) {
+			return isCoalesced(queuedMessage);
+		}).base();
+		auto const replacedMessages = std::remove_if(firstReplaceableMessage, queuedMessages.end(), [&](auto const &queuedMessage) {
+			return queuedMessage["object"] == message["object"] && queuedMessage["signal"] == message["signal"];
+		});
+		nbCoalescedMessages += static_cast<int>(std::distance(replacedMessages, queuedMessages.end()));
+		queuedMessages.erase(replacedMessages, queuedMessages.end());
+	}
+
+	queuedMessages.push_back(message);
+	flush();
+}
+
+void WebSocketTransport::coalesceSignal(QString const &objectName, QMetaMethod const &signal)
+{
+	coalescedSignals.emplace(objectName, signal.methodIndex());
+}
+
+QJsonObject WebSocketTransport::getMetrics() const
+{
+	return {
+		{"peerAddress", socket->peerAddress().toString()},
+		{"queuedMessages", static_cast<int>(queuedMessages.size())},
+		{"bytesToWrite", nbBytesToWrite},
+		{"coalescedMessages", nbCoalescedMessages},
+	};
+}
+
+QJsonObject WebSocketTransport::getAllMetrics()
+{
+	QJsonArray connections;
+	for (auto const &transport: instances) {
+		connections.append(transport->getMetrics());
+	}
+
+	return {{"connections", connections}};
+}
+
+void WebSocketTransport::bytesWritten(qint64 nbBytes)
+{
+	// The frame headers are also written, so the count is only an estimation
+	nbBytesToWrite = std::max<qint64>(0, nbBytesToWrite - nbBytes);
+	flush();
+}
+
+void WebSocketTransport::flush()
+{
+	while (!queuedMessages.empty() && nbBytesToWrite < maxBytesToWrite) {
+		QJsonDocument doc(queuedMessages.front());
+		queuedMessages.pop_front();
+		nbBytesToWrite += socket->sendTextMessage(QString::fromUtf8(doc.toJson(QJsonDocument::Compact)));
+	}
+}
+
+/** Only signal messages of QWebChannel, of type 1, can be coalesced */
+bool WebSocketTransport::isCoalesced(QJsonObject const &message) const
+{
+	return message["type"].toInt() == 1 && coalescedSignals.contains({message["object"].toString(), message["signal"].toInt(-1)});
 }
 
 void WebSocketTransport::textMessageReceived(const QString &messageData)
@@ -1,9 +1,20 @@
 #pragma once
 
+#include <QJsonObject>
+#include <QString>
 #include <QWebChannelAbstractTransport>
+#include <deque>
+#include <set>
+#include <utility>
 
+class QMetaMethod;
 class QWebSocket;
 
+/**
+ * Stops handing messages to the socket once too many bytes are waiting to be written, for instance because the browser tab is in background,
+ * and only keeps the latest of the queued messages of the coalesced signals until the socket catches up,
+ * without any message overtaking another one.
+ */
 class WebSocketTransport : public QWebChannelAbstractTransport
 {
 	Q_OBJECT
@@ -12,10 +23,37 @@ class WebSocketTransport : public QWebChannelAbstractTransport
 		virtual ~WebSocketTransport();
 		void sendMessage(const QJsonObject &message) override;
 
+		/** Only the latest queued emission of this signal of the registered object is sent */
+		void coalesceSignal(QString const &objectName, QMetaMethod const &signal);
+
+		QJsonObject getMetrics() const;
+
+		/** The metrics of all the open connections */
+		static QJsonObject getAllMetrics();
+
+		/** In bytes */
+		static constexpr qint64 maxBytesToWrite = 1 << 20;
+
 	protected slots:
 		void textMessageReceived(const QString &message);
+		void bytesWritten(qint64 nbBytes);
 
 	protected:
 		QWebSocket *socket;
-};
 
+		/** Given to the socket but not written yet */
+		qint64 nbBytesToWrite = 0;
+
+		/** Not given to the socket yet, because of the bytes still to write */
+		std::deque<QJsonObject> queuedMessages;
+
+		/** The name of the object and the index of the signal */
+		std::set<std::pair<QString, int>> coalescedSignals;
+
+		int nbCoalescedMessages = 0;
+
+		void flush();
+		bool isCoalesced(QJsonObject const &message) const;
+
+		static std::set<WebSocketTransport const*> instances;
+};
@@ -1,24 +1,22 @@
 #include <QCoreApplication>
-#include <QFile>
-#include <QFileInfo>
 #include <QHttpServer>
+#include <QHttpServerResponse>
 #include <QLocale>
 #include <QLocalServer>
 #include <QLocalSocket>
-#include <QMimeDatabase>
+#include <QMetaMethod>
 #include <QTranslator>
 #include <QWebChannel>
 #include <QWebSocketServer>
+#include <memory>
 #include "misc.h"
 #include "Communication.h"
+#include "JobServer.h"
+#include "SolutionStore.h"
 #include "Solver.h"
 #include "State.h"
+#include "StaticFileCache.h"
 #include "WebSocketTransport.h"
-#include "Objective/EvenDistributionBetweenTeachersObjective.h"
-#include "Objective/MinimalNumberOfSlotsObjective.h"
-#include "Objective/NoConsecutiveCollesObjective.h"
-#include "Objective/OnlyOneCollePerDayObjective.h"
-#include "Objective/SameSlotOnlyOnceInCycleObjective.h"
 
 #ifdef Q_OS_WIN
 	#include <Windows.h>
@@ -46,31 +44,27 @@ void createLocalServer() {
 	});
 }
 
-QFile getFileFromUrl(QUrl const &url = QUrl()) {
-	auto const &path = url.fileName().contains('.') ? url.path() : "index.html";
-	return QFile(QCoreApplication::applicationDirPath() + "/../user-interface/" + path);
-}
-
 void createHttpServer(int port) {
-	auto const indexFile = getFileFromUrl();
-	if (!indexFile.exists()) {
-		qStdout() << QCoreApplication::tr("Les fichiers de l'interface graphique n'ont pas été trouvés.") << Qt::endl;
-		return;
-	}
-
 	auto const server = new QHttpServer(QCoreApplication::instance());
-	server->setMissingHandler([] (const QHttpServerRequest &request, QHttpServerResponder &&responder) {
-		auto file = getFileFromUrl(request.url());
-		if (!file.open(QIODevice::ReadOnly)) {
-			return responder.write(QHttpServerResponse::StatusCode::NotFound);
-		}
-
-		QFileInfo fileInfo(file);
-		QMimeDatabase mimeDatabase;
-		QMimeType mimeType = mimeDatabase.mimeTypeForFile(fileInfo);
-		return responder.write(file.readAll(), mimeType.name().toUtf8());
+	server->route("/metrics", []() {
+		return QHttpServerResponse(WebSocketTransport::getAllMetrics());
 	});
 
+	// The jobs API is still served without the user interface, for the scripts which drive the solver directly
+	auto const jobServer = new JobServer(server);
+	jobServer->addRoutes(server);
+
+	auto const staticFileCache = std::make_shared<StaticFileCache>(QCoreApplication::applicationDirPath() + "/../user-interface/");
+	bool const hasUserInterface = staticFileCache->contains("index.html");
+	if (hasUserInterface) {
+		server->setMissingHandler([staticFileCache] (const QHttpServerRequest &request, QHttpServerResponder &&responder) {
+			staticFileCache->respond(request, std::move(responder));
+		});
+	}
+	else {
+		qStdout() << QCoreApplication::tr("Les fichiers de l'interface graphique n'ont pas été trouvés.") << Qt::endl;
+	}
+
 	if (!server->listen(QHostAddress::LocalHost, port)) {
 		qStdout() << QCoreApplication::tr("Impossible d'ouvrir le serveur HTTP sur le port %1.").arg(port) << Qt::endl;
 		server->deleteLater();
@@ -78,7 +72,9 @@ void createHttpServer(int port) {
 	}
 
 	#ifdef Q_OS_WIN
-		ShellExecute(NULL, L"open", QString("http://localhost:%1").arg(port).toStdWString().c_str(), NULL, NULL, SW_SHOW);
+		if (hasUserInterface) {
+			ShellExecute(NULL, L"open", QString("http://localhost:%1").arg(port).toStdWString().c_str(), NULL, NULL, SW_SHOW);
+		}
 	#endif
 }
 
@@ -96,7 +92,11 @@ QWebChannel* createWebSocketServer(int port) {
 	/* @todo Only accepts a single connection */
 	auto const channel = new QWebChannel(QCoreApplication::instance());
 	QObject::connect(server, &QWebSocketServer::newConnection, [=]() {
-		channel->connectTo(new WebSocketTransport(server->nextPendingConnection()));
+		// A slow client only needs the latest solution and progress, so the older ones are dropped when it falls behind
+		auto const transport = new WebSocketTransport(server->nextPendingConnection());
+		transport->coalesceSignal("communication", QMetaMethod::fromSignal(&Communication::solutionFound));
+		transport->coalesceSignal("communication", QMetaMethod::fromSignal(&Communication::progressReported));
+		channel->connectTo(transport);
 	});
 
 	return channel;
@@ -119,24 +119,13 @@ int main(int argc, char *argv[])
 	createHttpServer(4200);
 	auto const channel = createWebSocketServer(4201);
 
-	const EvenDistributionBetweenTeachersObjective evenDistributionBetweenTeachersObjective;
-	const MinimalNumberOfSlotsObjective minimalNumberOfSlotsObjective;
-	const NoConsecutiveCollesObjective noConsecutiveCollesObjective;
-	const OnlyOneCollePerDayObjective onlyOneCollePerDayObjective;
-	const SameSlotOnlyOnceInCycleObjective sameSlotOnlyOnceInCycleObjective;
-
-	std::vector<Objective const *> objectives = {
-		&evenDistributionBetweenTeachersObjective,
-		&minimalNumberOfSlotsObjective,
-		&noConsecutiveCollesObjective,
-		&onlyOneCollePerDayObjective,
-		&sameSlotOnlyOnceInCycleObjective,
-	};
-
-	State state(objectives);
+	State state;
 	Solver solver(state);
 
-	Communication communication(state, solver);
+	SolutionStore solutionStore(SolutionStore::getDefaultFilePath());
+	solutionStore.compact();
+
+	Communication communication(state, solver, solutionStore);
 	channel->registerObject("communication", &communication);
 	preventSleepMode(true);
 
@@ -5,8 +5,19 @@
 #ifdef Q_OS_WIN
 	#include <cstdio>
 	#include <Windows.h>
+	#include <psapi.h>
 #endif
 
+#ifdef Q_OS_LINUX
+	#include <fstream>
+	#include <string>
+	#include <malloc.h>
+#endif
+
+ComputationStoppedException::ComputationStoppedException(): std::runtime_error("The computation has been stopped.")
+{
+}
+
 void initStdout()
 {
 	#ifdef Q_OS_WIN
@@ -39,3 +50,44 @@ void preventSleepMode(bool shouldPreventSleepMode)
 		#endif
 	}
 }
+
+void throwIfComputationStopped(std::atomic<bool> const &shouldComputationBeStopped)
+{
+	if (shouldComputationBeStopped) {
+		throw ComputationStoppedException();
+	}
+}
+
+MemoryUsage getMemoryUsage()
+{
+	MemoryUsage memoryUsage = {0, 0, 0};
+
+	#ifdef Q_OS_WIN
+		PROCESS_MEMORY_COUNTERS counters;
+		if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+			memoryUsage.residentSize = counters.WorkingSetSize / (1024.0 * 1024.0);
+			memoryUsage.peakResidentSize = counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+		}
+	#endif
+
+	#ifdef Q_OS_LINUX
+		// The sizes are given in kilobytes
+		std::ifstream status("/proc/self/status");
+		std::string line;
+		while (std::getline(status, line)) {
+			if (line.starts_with("VmRSS:")) {
+				memoryUsage.residentSize = std::stod(line.substr(6)) / 1024;
+			}
+			else if (line.starts_with("VmHWM:")) {
+				memoryUsage.peakResidentSize = std::stod(line.substr(6)) / 1024;
+			}
+		}
+
+		#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+			auto const &info = mallinfo2();
+			memoryUsage.heapSize = (info.uordblks + info.hblkhd) / (1024.0 * 1024.0);
+		#endif
+	#endif
+
+	return memoryUsage;
+}
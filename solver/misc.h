@@ -1,8 +1,27 @@
 #pragma once
 
+#include <atomic>
+#include <stdexcept>
+
 class QTextStream;
 
+/** In megabytes, 0 meaning that the value is not available on the platform */
+struct MemoryUsage {
+	double residentSize;
+	double peakResidentSize;
+	double heapSize;
+};
+
+/** Thrown at a checkpoint of a long operation when the computation has been requested to stop */
+class ComputationStoppedException : public std::runtime_error
+{
+	public:
+		ComputationStoppedException();
+};
+
 void initStdout();
 QTextStream& qStdout();
 unsigned int divideCeil(unsigned int a, unsigned int b);
 void preventSleepMode(bool shouldPreventSleepMode);
+void throwIfComputationStopped(std::atomic<bool> const &shouldComputationBeStopped);
+MemoryUsage getMemoryUsage();
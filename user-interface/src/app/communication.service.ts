@@ -25,6 +25,25 @@ type JsonColle = {
 type JsonObjectiveComputation = {
 	objectiveName: string,
 	value: number,
+	lowerBound: number,
+};
+
+type JsonSearchStatistics = {
+	elapsedTime: number,
+	nbSolutions: number,
+	objectiveValue: number,
+	bestBound: number,
+	gap: number,
+	improvements: [number, number][],
+	phase: 'building' | 'repair' | 'greedy' | 'globalSearch' | 'neighbourhoodSearch' | 'localSearch' | 'finished',
+	nbRunningSearches: number,
+	memoryUsages: {
+		phase: 'variables' | 'constraints' | 'objectives' | 'model' | 'search',
+		residentSize: number,
+		peakResidentSize: number,
+		heapSize: number,
+		allocatedSize: number,
+	}[],
 };
 
 type Communication = {
@@ -34,8 +53,9 @@ type Communication = {
 	},
 
 	signals: {
-		solutionFound: (colles: JsonColle[], objectiveComputations: JsonObjectiveComputation[]) => void,
+		solutionFound: (colles: JsonColle[], objectiveComputations: JsonObjectiveComputation[], statistics: JsonSearchStatistics) => void,
 		computationFinished: (success: boolean) => void,
+		progressReported: (statistics: JsonSearchStatistics) => void,
 	},
 }
 